@@ -11,173 +11,2469 @@
 #include <Arduino.h>
 #include <Wire.h>
 
+// Set to 1 on FreeRTOS targets to serialize bus access across tasks/cores
+// and publish telemetry through a lock-free seqlock
+#ifndef BQ25723_THREAD_SAFE
+#define BQ25723_THREAD_SAFE 0
+#endif
+
+#if BQ25723_THREAD_SAFE
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
 // Default I2C address for BQ25723
 #define BQ25723_I2C_ADDR_DEFAULT 0x6B
 #define BQ25723_I2C_ADDR_ALT     0x6A
 
-// Common BQ25723 register addresses
-#define BQ25723_REG_CHARGE_OPTION_0    0x00
-#define BQ25723_REG_CHARGE_CURRENT     0x02
-#define BQ25723_REG_CHARGE_VOLTAGE     0x04
-#define BQ25723_REG_OTG_VOLTAGE        0x06
-#define BQ25723_REG_OTG_CURRENT        0x08
-#define BQ25723_REG_INPUT_VOLTAGE      0x0A
-#define BQ25723_REG_VSYS_MIN           0x0C
-#define BQ25723_REG_IIN_HOST           0x0E
-#define BQ25723_REG_CHARGER_STATUS     0x20
-#define BQ25723_REG_PROCHOT_STATUS     0x22
-#define BQ25723_REG_IIN_DPM            0x24
-#define BQ25723_REG_ADCVBUS_PSYS       0x26
-#define BQ25723_REG_ADCIBAT            0x28
-#define BQ25723_REG_ADCIINCMPIN        0x2A
-#define BQ25723_REG_ADCVSYSVBAT        0x2C
-#define BQ25723_REG_MANUFACTURER_ID    0x2E
-#define BQ25723_REG_DEVICE_ID          0x2F
-#define BQ25723_REG_CHARGE_OPTION_1    0x30
-#define BQ25723_REG_CHARGE_OPTION_2    0x32
-#define BQ25723_REG_CHARGE_OPTION_3    0x34
-#define BQ25723_REG_PROCHOT_OPTION_0   0x36
-#define BQ25723_REG_PROCHOT_OPTION_1   0x38
-#define BQ25723_REG_ADC_OPTION         0x3A
-#define BQ25723_REG_CHARGE_OPTION_4    0x3C
-#define BQ25723_REG_VMIN_ACT_PROT      0x3E
+// Largest number of bytes a single Wire transfer can hold
+#ifndef BQ25723_I2C_BUFFER_SIZE
+#if defined(I2C_BUFFER_LENGTH)
+#define BQ25723_I2C_BUFFER_SIZE I2C_BUFFER_LENGTH
+#elif defined(BUFFER_LENGTH)
+#define BQ25723_I2C_BUFFER_SIZE BUFFER_LENGTH
+#else
+#define BQ25723_I2C_BUFFER_SIZE 32
+#endif
+#endif
+
+// Maximum number of 16-bit registers fetched in one burst transaction
+#define BQ25723_BURST_MAX_WORDS (BQ25723_I2C_BUFFER_SIZE / 2)
+
+// Maximum number of 16-bit registers written in one burst (after the pointer byte)
+#define BQ25723_BURST_MAX_WRITE_WORDS ((BQ25723_I2C_BUFFER_SIZE - 1) / 2)
+
+// Clock rates tried by clock negotiation, fastest last
+#define BQ25723_I2C_SPEED_STANDARD   100000
+#define BQ25723_I2C_SPEED_FAST       400000
+#define BQ25723_I2C_SPEED_FAST_PLUS  1000000
+
+// Consecutive failed transactions before a negotiated clock steps down
+#ifndef BQ25723_CLOCK_FALLBACK_FAILURES
+#define BQ25723_CLOCK_FALLBACK_FAILURES 3
+#endif
+
+// Reads of the ID register that must match before a clock rate is accepted
+#ifndef BQ25723_CLOCK_PROBE_READS
+#define BQ25723_CLOCK_PROBE_READS 4
+#endif
+
+// Number of 16-bit register slots (even addresses 0x00-0x3E)
+#define BQ25723_REG_COUNT 32
+
+// Entries in the register name table (every address 0x00-0x3F)
+#define BQ25723_NAME_TABLE_SIZE 64
+
+// Stack buffer used by dumpRegisters(Print&); output is flushed when full
+#ifndef BQ25723_DUMP_BUFFER_SIZE
+#define BQ25723_DUMP_BUFFER_SIZE 1024
+#endif
+
+// Longest dumpRegisters() line: "0x36 (PROCHOT_OPTION_0): 0xFFFF\r\n"
+#define BQ25723_DUMP_LINE_MAX 40
+
+// Watchdog keep-alive windows, in percent of the timeout since the last reset:
+// from PIGGYBACK on, writes next to CHARGE_CURRENT/CHARGE_VOLTAGE are extended
+// to cover them; from DEADLINE on, serviceWatchdog() issues a dedicated write
+#ifndef BQ25723_WATCHDOG_PIGGYBACK_PCT
+#define BQ25723_WATCHDOG_PIGGYBACK_PCT 50
+#endif
+#ifndef BQ25723_WATCHDOG_DEADLINE_PCT
+#define BQ25723_WATCHDOG_DEADLINE_PCT 75
+#endif
+
+// Bus recovery (see recover()): attempts, and the delay before the second
+// attempt in milliseconds, doubled before each further one
+#ifndef BQ25723_RECOVERY_ATTEMPTS
+#define BQ25723_RECOVERY_ATTEMPTS 4
+#endif
+#ifndef BQ25723_RECOVERY_BACKOFF_MS
+#define BQ25723_RECOVERY_BACKOFF_MS 1
+#endif
+
+// After a failed automatic recovery the link is down: accesses fail without
+// bus traffic until this many milliseconds have passed, then run recover()
+// again. The wait doubles after each failure up to the maximum.
+#ifndef BQ25723_RECOVERY_RETRY_MS
+#define BQ25723_RECOVERY_RETRY_MS 50
+#endif
+#ifndef BQ25723_RECOVERY_RETRY_MAX_MS
+#define BQ25723_RECOVERY_RETRY_MAX_MS 5000
+#endif
+
+// Set to 1 to record bus transaction statistics (see getStats())
+#ifndef BQ25723_ENABLE_STATS
+#define BQ25723_ENABLE_STATS 0
+#endif
+
+// Set to 1 to log every bus transaction into a trace ring (see drainTrace())
+#ifndef BQ25723_ENABLE_TRACE
+#define BQ25723_ENABLE_TRACE 0
+#endif
+
+// Trace ring size in entries (power of two, 12 bytes each)
+#ifndef BQ25723_TRACE_CAPACITY
+#define BQ25723_TRACE_CAPACITY 128
+#endif
+
+#if BQ25723_ENABLE_TRACE
+#include "BQ25723Ring.hpp"
+#endif
+
+// Bus transaction status (Wire endTransmission() codes, plus short reads)
+enum BQ25723BusStatus : uint8_t {
+    BQ25723_BUS_OK            = 0,
+    BQ25723_BUS_DATA_TOO_LONG = 1,
+    BQ25723_BUS_NACK_ADDRESS  = 2,
+    BQ25723_BUS_NACK_DATA     = 3,
+    BQ25723_BUS_ERROR         = 4,
+    BQ25723_BUS_TIMEOUT       = 5,
+    BQ25723_BUS_SHORT_READ    = 6,  // requestFrom() returned fewer bytes
+    BQ25723_BUS_NOT_READY     = 7   // Driver not initialized, nothing was sent
+};
+
+/**
+ * Register value paired with the status of the read that produced it
+ * Every 16-bit value is legal register content, so errors travel in status
+ * instead of a sentinel value.
+ */
+struct BQ25723Result {
+    uint16_t value;     // Valid only when ok()
+    uint8_t status;     // BQ25723BusStatus
+    
+    /**
+     * Check if the read succeeded
+     * @return true if value holds register content
+     */
+    bool ok() const {
+        return status == BQ25723_BUS_OK;
+    }
+    
+    explicit operator bool() const {
+        return ok();
+    }
+    
+    /**
+     * Get the value, or a fallback if the read failed
+     * @param fallback Value returned on failure
+     * @return Register value or fallback
+     */
+    uint16_t valueOr(uint16_t fallback) const {
+        return ok() ? value : fallback;
+    }
+};
+
+#if BQ25723_ENABLE_TRACE
+// Trace entry flags
+#define BQ25723_TRACE_WRITE 0x01
+
+// Trace packet tag; see drainTrace() for the layout
+#define BQ25723_TRACE_PACKET 0xB3
+
+// Bytes per encoded trace entry
+#define BQ25723_TRACE_ENTRY_SIZE 12
+
+// One traced bus transaction
+struct BQ25723TraceEntry {
+    uint32_t timestampUs;   // micros() at the start of the transaction
+    uint16_t latencyUs;     // Duration, saturated at 65535
+    uint16_t value;         // First word transferred (0 if a read failed)
+    uint8_t regAddr;
+    uint8_t count;          // Words transferred
+    uint8_t flags;          // BQ25723_TRACE_* bits
+    uint8_t status;         // BQ25723BusStatus
+};
+#endif
+
+#if BQ25723_ENABLE_STATS
+// Bus transaction statistics
+struct BQ25723BusStats {
+    uint32_t reads[BQ25723_REG_COUNT];   // Per register slot (address / 2)
+    uint32_t writes[BQ25723_REG_COUNT];
+    uint32_t transactions;
+    uint32_t failures;                   // All failed transactions
+    uint32_t nacks;                      // Address or data NACK
+    uint32_t shortReads;
+    uint32_t bytesWritten;               // Register pointer and data bytes
+    uint32_t bytesRead;
+    uint32_t minLatencyUs;               // UINT32_MAX until the first transaction
+    uint32_t maxLatencyUs;
+    uint64_t totalLatencyUs;
+    
+    /**
+     * Get the mean transaction latency
+     * @return Average latency in microseconds, 0 if no transactions
+     */
+    uint32_t averageLatencyUs() const {
+        return transactions ? (uint32_t)(totalLatencyUs / transactions) : 0;
+    }
+};
+#endif
+
+// Register flags
+#define BQ25723_FLAG_READ_ONLY  0x01  // Writes are rejected at compile time
+#define BQ25723_FLAG_VOLATILE   0x02  // Changes without host writes, never cached
+#define BQ25723_FLAG_UNKNOWN    0x80  // Not a documented register
+
+// BQ25723 register map: X(name, address, flags)
+// Single source for the address constants, typed descriptors, name lookup
+// and register dumps.
+#define BQ25723_REGISTER_MAP(X) \
+    X(CHARGE_OPTION_0,  0x00, 0) \
+    X(CHARGE_CURRENT,   0x02, 0) \
+    X(CHARGE_VOLTAGE,   0x04, 0) \
+    X(OTG_VOLTAGE,      0x06, 0) \
+    X(OTG_CURRENT,      0x08, 0) \
+    X(INPUT_VOLTAGE,    0x0A, 0) \
+    X(VSYS_MIN,         0x0C, 0) \
+    X(IIN_HOST,         0x0E, 0) \
+    X(CHARGER_STATUS,   0x20, BQ25723_FLAG_VOLATILE) \
+    X(PROCHOT_STATUS,   0x22, BQ25723_FLAG_VOLATILE) \
+    X(IIN_DPM,          0x24, BQ25723_FLAG_READ_ONLY | BQ25723_FLAG_VOLATILE) \
+    X(ADCVBUS_PSYS,     0x26, BQ25723_FLAG_READ_ONLY | BQ25723_FLAG_VOLATILE) \
+    X(ADCIBAT,          0x28, BQ25723_FLAG_READ_ONLY | BQ25723_FLAG_VOLATILE) \
+    X(ADCIINCMPIN,      0x2A, BQ25723_FLAG_READ_ONLY | BQ25723_FLAG_VOLATILE) \
+    X(ADCVSYSVBAT,      0x2C, BQ25723_FLAG_READ_ONLY | BQ25723_FLAG_VOLATILE) \
+    X(MANUFACTURER_ID,  0x2E, BQ25723_FLAG_READ_ONLY) \
+    X(DEVICE_ID,        0x2F, BQ25723_FLAG_READ_ONLY) \
+    X(CHARGE_OPTION_1,  0x30, 0) \
+    X(CHARGE_OPTION_2,  0x32, 0) \
+    X(CHARGE_OPTION_3,  0x34, 0) \
+    X(PROCHOT_OPTION_0, 0x36, 0) \
+    X(PROCHOT_OPTION_1, 0x38, 0) \
+    X(ADC_OPTION,       0x3A, BQ25723_FLAG_VOLATILE) /* ADC_START self-clears */ \
+    X(CHARGE_OPTION_4,  0x3C, 0) \
+    X(VMIN_ACT_PROT,    0x3E, 0)
+
+// Register address constants (BQ25723_REG_CHARGE_OPTION_0, ...)
+#define BQ25723_X_ADDRESS(name, addr, flags) constexpr uint8_t BQ25723_REG_##name = addr;
+BQ25723_REGISTER_MAP(BQ25723_X_ADDRESS)
+#undef BQ25723_X_ADDRESS
+
+/**
+ * Compile-time register descriptor
+ * @tparam Address Register address
+ * @tparam Flags BQ25723_FLAG_* bits
+ */
+template <uint8_t Address, uint8_t Flags>
+struct BQ25723Register {
+    static constexpr uint8_t address = Address;
+    static constexpr uint8_t flags = Flags;
+    static constexpr bool readOnly = (Flags & BQ25723_FLAG_READ_ONLY) != 0;
+    static constexpr bool isVolatile = (Flags & BQ25723_FLAG_VOLATILE) != 0;
+};
+
+template <uint8_t A, uint8_t F> constexpr uint8_t BQ25723Register<A, F>::address;
+template <uint8_t A, uint8_t F> constexpr uint8_t BQ25723Register<A, F>::flags;
+template <uint8_t A, uint8_t F> constexpr bool BQ25723Register<A, F>::readOnly;
+template <uint8_t A, uint8_t F> constexpr bool BQ25723Register<A, F>::isVolatile;
+
+// Register descriptors (BQ25723Regs::CHARGE_OPTION_0, ...)
+namespace BQ25723Regs {
+#define BQ25723_X_DESCRIPTOR(name, addr, flags) typedef BQ25723Register<addr, flags> name;
+BQ25723_REGISTER_MAP(BQ25723_X_DESCRIPTOR)
+#undef BQ25723_X_DESCRIPTOR
+}
+
+/**
+ * Integer fixed-point scale: value = floor(code * Num / Den)
+ * Both directions are one multiply and one shift by constants folded at
+ * compile time, exact for every 16-bit input (the shift is 16 plus the
+ * bits of the divisor, so the rounded-up reciprocal never carries into
+ * the integer part). When Den divides Num the multiply is all that is left.
+ */
+template <uint32_t Num, uint32_t Den>
+struct BQ25723Scale {
+    static_assert(Num > 0 && Den > 0, "Scale must be positive");
+    
+    // ceil(log2(x))
+    static constexpr uint8_t bits(uint32_t x) {
+        return (x > 1) ? 1 + bits((x + 1) / 2) : 0;
+    }
+    
+    static constexpr uint8_t mulShift = 16 + bits(Den);
+    static constexpr uint64_t mulFactor = ((uint64_t)Num << mulShift) / Den + 1;
+    static constexpr uint8_t divShift = 16 + bits(Num);
+    static constexpr uint64_t divFactor = ((uint64_t)Den << divShift) / Num + 1;
+    
+    // floor(x * Num / Den)
+    static constexpr uint32_t multiply(uint16_t x) {
+        return (Num % Den == 0) ? x * (Num / Den) : (uint32_t)((x * mulFactor) >> mulShift);
+    }
+    
+    // floor(x * Den / Num)
+    static constexpr uint32_t divide(uint16_t x) {
+        return (Den % Num == 0) ? x * (Den / Num) : (uint32_t)((x * divFactor) >> divShift);
+    }
+};
+
+// Sense resistors in milliohms; current field and ADC LSBs scale by 10 / R
+#ifndef BQ25723_RSENSE_CHARGE_MOHM
+#define BQ25723_RSENSE_CHARGE_MOHM 10   // RSR: battery charge/discharge current
+#endif
+#ifndef BQ25723_RSENSE_INPUT_MOHM
+#define BQ25723_RSENSE_INPUT_MOHM 10    // RAC: input (and OTG output) current
+#endif
+
+/**
+ * Compile-time bit field descriptor
+ * Physical value = code * Lsb * 10 / SenseMohm + Offset (units noted per
+ * field), converted with integer fixed-point only.
+ * @tparam Reg Register descriptor holding the field
+ * @tparam Shift Position of the field's least significant bit
+ * @tparam Width Field width in bits
+ * @tparam Lsb Weight of one code step (with a 10 mOhm sense resistor)
+ * @tparam Offset Value represented by code 0
+ * @tparam SenseMohm Sense resistor the field's current scales with
+ */
+template <typename Reg, uint8_t Shift, uint8_t Width, uint16_t Lsb = 1, uint16_t Offset = 0,
+          uint8_t SenseMohm = 10>
+struct BQ25723Field {
+    static_assert(Width >= 1 && Shift + Width <= 16, "Field does not fit a 16-bit register");
+    static_assert(SenseMohm > 0, "Sense resistor must be non-zero");
+    
+    typedef Reg reg;
+    typedef BQ25723Scale<(uint32_t)Lsb * 10, SenseMohm> scale;
+    static constexpr uint8_t shift = Shift;
+    static constexpr uint8_t width = Width;
+    static constexpr uint16_t maxCode = (uint16_t)((1UL << Width) - 1);
+    static constexpr uint16_t mask = (uint16_t)(maxCode << Shift);
+    static constexpr uint16_t lsb = Lsb;
+    static constexpr uint16_t offset = Offset;
+    
+    // Convert a field code to its physical value (saturates at 0xFFFF)
+    static constexpr uint16_t toValue(uint16_t code) {
+        return (scale::multiply(code) + Offset > 0xFFFF) ? 0xFFFF
+                                                          : (uint16_t)(scale::multiply(code) + Offset);
+    }
+    
+    // Convert a physical value to the largest code not above it, clamped
+    // to the field range
+    static constexpr uint16_t fromValue(uint16_t value) {
+        return (value <= Offset) ? 0
+             : (scale::divide(value - Offset) > maxCode) ? maxCode
+             : (uint16_t)scale::divide(value - Offset);
+    }
+    
+    // Extract the field code from a register word
+    static constexpr uint16_t get(uint16_t word) {
+        return (word & mask) >> Shift;
+    }
+    
+    // Position a field code within a register word
+    static constexpr uint16_t encode(uint16_t code) {
+        return (uint16_t)((code << Shift) & mask);
+    }
+    
+    // Convert a register word to the field's physical value
+    static constexpr uint16_t decode(uint16_t word) {
+        return toValue(get(word));
+    }
+    
+    // Replace the field code within a register word
+    static constexpr uint16_t set(uint16_t word, uint16_t code) {
+        return (uint16_t)((word & ~mask) | encode(code));
+    }
+};
+
+template <uint32_t N, uint32_t D> constexpr uint8_t BQ25723Scale<N, D>::mulShift;
+template <uint32_t N, uint32_t D> constexpr uint64_t BQ25723Scale<N, D>::mulFactor;
+template <uint32_t N, uint32_t D> constexpr uint8_t BQ25723Scale<N, D>::divShift;
+template <uint32_t N, uint32_t D> constexpr uint64_t BQ25723Scale<N, D>::divFactor;
+
+template <typename R, uint8_t S, uint8_t W, uint16_t L, uint16_t O, uint8_t M> constexpr uint8_t BQ25723Field<R, S, W, L, O, M>::shift;
+template <typename R, uint8_t S, uint8_t W, uint16_t L, uint16_t O, uint8_t M> constexpr uint8_t BQ25723Field<R, S, W, L, O, M>::width;
+template <typename R, uint8_t S, uint8_t W, uint16_t L, uint16_t O, uint8_t M> constexpr uint16_t BQ25723Field<R, S, W, L, O, M>::maxCode;
+template <typename R, uint8_t S, uint8_t W, uint16_t L, uint16_t O, uint8_t M> constexpr uint16_t BQ25723Field<R, S, W, L, O, M>::mask;
+template <typename R, uint8_t S, uint8_t W, uint16_t L, uint16_t O, uint8_t M> constexpr uint16_t BQ25723Field<R, S, W, L, O, M>::lsb;
+template <typename R, uint8_t S, uint8_t W, uint16_t L, uint16_t O, uint8_t M> constexpr uint16_t BQ25723Field<R, S, W, L, O, M>::offset;
+
+// Field descriptors; current fields scale with BQ25723_RSENSE_*_MOHM
+namespace BQ25723Fields {
+    // CHARGE_OPTION_0
+    typedef BQ25723Field<BQ25723Regs::CHARGE_OPTION_0, 15, 1> EN_LWPWR;
+    typedef BQ25723Field<BQ25723Regs::CHARGE_OPTION_0, 13, 2> WDTMR_ADJ;
+    typedef BQ25723Field<BQ25723Regs::CHARGE_OPTION_0, 12, 1> IIN_DPM_AUTO_DISABLE;
+    typedef BQ25723Field<BQ25723Regs::CHARGE_OPTION_0, 11, 1> OTG_ON_CHRGOK;
+    typedef BQ25723Field<BQ25723Regs::CHARGE_OPTION_0, 10, 1> EN_OOA;
+    typedef BQ25723Field<BQ25723Regs::CHARGE_OPTION_0,  9, 1> PWM_FREQ;
+    typedef BQ25723Field<BQ25723Regs::CHARGE_OPTION_0,  1, 1> EN_IIN_DPM;
+    typedef BQ25723Field<BQ25723Regs::CHARGE_OPTION_0,  0, 1> CHRG_INHIBIT;
+    
+    // Charge, OTG and input limits
+    typedef BQ25723Field<BQ25723Regs::CHARGE_CURRENT,  6,  7,  64,    0, BQ25723_RSENSE_CHARGE_MOHM> CHARGE_CURRENT;  // mA
+    typedef BQ25723Field<BQ25723Regs::CHARGE_VOLTAGE,  3, 12,   8>                                   CHARGE_VOLTAGE;  // mV
+    typedef BQ25723Field<BQ25723Regs::OTG_VOLTAGE,     2, 12,   8>                                   OTG_VOLTAGE;     // mV
+    typedef BQ25723Field<BQ25723Regs::OTG_CURRENT,     8,  7,  50,    0, BQ25723_RSENSE_INPUT_MOHM>  OTG_CURRENT;     // mA
+    typedef BQ25723Field<BQ25723Regs::INPUT_VOLTAGE,   6,  8,  64, 3200>                             INPUT_VOLTAGE;   // mV
+    typedef BQ25723Field<BQ25723Regs::VSYS_MIN,        8,  8, 100>                                   VSYS_MIN;        // mV
+    typedef BQ25723Field<BQ25723Regs::IIN_HOST,        8,  7,  50,    0, BQ25723_RSENSE_INPUT_MOHM>  IIN_HOST;        // mA
+    typedef BQ25723Field<BQ25723Regs::IIN_DPM,         8,  7,  50,    0, BQ25723_RSENSE_INPUT_MOHM>  IIN_DPM;         // mA
+    
+    // CHARGER_STATUS
+    typedef BQ25723Field<BQ25723Regs::CHARGER_STATUS, 15, 1> AC_STAT;
+    typedef BQ25723Field<BQ25723Regs::CHARGER_STATUS, 14, 1> ICO_DONE;
+    typedef BQ25723Field<BQ25723Regs::CHARGER_STATUS, 13, 1> IN_VAP;
+    typedef BQ25723Field<BQ25723Regs::CHARGER_STATUS, 12, 1> IN_VINDPM;
+    typedef BQ25723Field<BQ25723Regs::CHARGER_STATUS, 11, 1> IN_IIN_DPM;
+    typedef BQ25723Field<BQ25723Regs::CHARGER_STATUS, 10, 1> IN_FCHRG;
+    typedef BQ25723Field<BQ25723Regs::CHARGER_STATUS,  9, 1> IN_PCHRG;
+    typedef BQ25723Field<BQ25723Regs::CHARGER_STATUS,  8, 1> IN_OTG;
+    typedef BQ25723Field<BQ25723Regs::CHARGER_STATUS,  0, 8> FAULTS;
+    
+    // CHARGE_OPTION_3
+    typedef BQ25723Field<BQ25723Regs::CHARGE_OPTION_3, 14, 1> RESET_REG;   // Self-clearing
+    
+    // PROCHOT_STATUS
+    typedef BQ25723Field<BQ25723Regs::PROCHOT_STATUS, 14, 1> EN_PROCHOT_EXT;
+    typedef BQ25723Field<BQ25723Regs::PROCHOT_STATUS, 12, 2> PROCHOT_WIDTH;
+    typedef BQ25723Field<BQ25723Regs::PROCHOT_STATUS, 11, 1> PROCHOT_CLEAR;
+    typedef BQ25723Field<BQ25723Regs::PROCHOT_STATUS,  0, 10> PROCHOT_STAT;
+    
+    // PROCHOT_OPTION_0
+    typedef BQ25723Field<BQ25723Regs::PROCHOT_OPTION_0, 11, 5,   5, 105> ILIM2_VTH;   // % of IIN_DPM
+    typedef BQ25723Field<BQ25723Regs::PROCHOT_OPTION_0,  9, 2> ICRIT_DEG;
+    typedef BQ25723Field<BQ25723Regs::PROCHOT_OPTION_0,  8, 1> PROCHOT_VINDPM_80_90;
+    typedef BQ25723Field<BQ25723Regs::PROCHOT_OPTION_0,  2, 6> VSYS_VTH;
+    typedef BQ25723Field<BQ25723Regs::PROCHOT_OPTION_0,  1, 1> INOM_DEG;
+    typedef BQ25723Field<BQ25723Regs::PROCHOT_OPTION_0,  0, 1> LOWER_PROCHOT_VINDPM;
+    
+    // PROCHOT_OPTION_1
+    typedef BQ25723Field<BQ25723Regs::PROCHOT_OPTION_1, 10, 6, 512,   0, BQ25723_RSENSE_CHARGE_MOHM> IDCHG_VTH;  // mA
+    typedef BQ25723Field<BQ25723Regs::PROCHOT_OPTION_1,  8, 2> IDCHG_DEG;
+    typedef BQ25723Field<BQ25723Regs::PROCHOT_OPTION_1,  0, 8> PROCHOT_PROFILE;
+    
+    // ADC results (PSYS and CMPIN assume the 3.06 V full-scale range set by configureAdc())
+    typedef BQ25723Field<BQ25723Regs::ADCVBUS_PSYS,  8, 8,  96>                                   ADC_VBUS;   // mV
+    typedef BQ25723Field<BQ25723Regs::ADCVBUS_PSYS,  0, 8,  12>                                   ADC_PSYS;   // mV
+    typedef BQ25723Field<BQ25723Regs::ADCIBAT,       8, 7,  64,    0, BQ25723_RSENSE_CHARGE_MOHM> ADC_ICHG;   // mA
+    typedef BQ25723Field<BQ25723Regs::ADCIBAT,       0, 7, 256,    0, BQ25723_RSENSE_CHARGE_MOHM> ADC_IDCHG;  // mA
+    typedef BQ25723Field<BQ25723Regs::ADCIINCMPIN,   8, 8,  50,    0, BQ25723_RSENSE_INPUT_MOHM>  ADC_IIN;    // mA
+    typedef BQ25723Field<BQ25723Regs::ADCIINCMPIN,   0, 8,  12>                                   ADC_CMPIN;  // mV
+    typedef BQ25723Field<BQ25723Regs::ADCVSYSVBAT,   8, 8,  64, 2880>                             ADC_VSYS;   // mV
+    typedef BQ25723Field<BQ25723Regs::ADCVSYSVBAT,   0, 8,  64, 2880>                             ADC_VBAT;   // mV
+    
+    // Identification
+    typedef BQ25723Field<BQ25723Regs::MANUFACTURER_ID, 0, 8> MANUFACTURER_ID;
+    typedef BQ25723Field<BQ25723Regs::DEVICE_ID,       0, 8> DEVICE_ID;
+    
+    // ADC_OPTION
+    typedef BQ25723Field<BQ25723Regs::ADC_OPTION, 15, 1> ADC_CONV;
+    typedef BQ25723Field<BQ25723Regs::ADC_OPTION, 14, 1> ADC_START;
+    typedef BQ25723Field<BQ25723Regs::ADC_OPTION, 13, 1> ADC_FULLSCALE;
+    typedef BQ25723Field<BQ25723Regs::ADC_OPTION,  0, 8> EN_ADC;
+}
+
+// CHARGER_STATUS fault bits (FAULTS field)
+#define BQ25723_FAULT_ACOV        0x80
+#define BQ25723_FAULT_BATOC       0x40
+#define BQ25723_FAULT_ACOC        0x20
+#define BQ25723_FAULT_SYSOVP      0x10
+#define BQ25723_FAULT_VSYS_UVP    0x08
+#define BQ25723_FAULT_CONV_OFF    0x04
+#define BQ25723_FAULT_OTG_OVP     0x02
+#define BQ25723_FAULT_OTG_UVP     0x01
+
+// PROCHOT_STATUS trip source bits (PROCHOT_STAT field)
+#define BQ25723_PROCHOT_VAP_FAIL      0x200
+#define BQ25723_PROCHOT_EXIT_VAP      0x100
+#define BQ25723_PROCHOT_VINDPM        0x080
+#define BQ25723_PROCHOT_COMP          0x040
+#define BQ25723_PROCHOT_ICRIT         0x020
+#define BQ25723_PROCHOT_INOM          0x010
+#define BQ25723_PROCHOT_IDCHG1        0x008
+#define BQ25723_PROCHOT_VSYS          0x004
+#define BQ25723_PROCHOT_BAT_REMOVAL   0x002
+#define BQ25723_PROCHOT_ADPT_REMOVAL  0x001
+
+// ADC channel enable bits (ADC_OPTION[7:0])
+#define BQ25723_ADC_CH_VBAT   0x01
+#define BQ25723_ADC_CH_VSYS   0x02
+#define BQ25723_ADC_CH_ICHG   0x04
+#define BQ25723_ADC_CH_IDCHG  0x08
+#define BQ25723_ADC_CH_IIN    0x10
+#define BQ25723_ADC_CH_PSYS   0x20
+#define BQ25723_ADC_CH_VBUS   0x40
+#define BQ25723_ADC_CH_CMPIN  0x80
+#define BQ25723_ADC_CH_ALL    0xFF
+
+// Number of ADC result registers (ADCVBUS_PSYS through ADCVSYSVBAT)
+#define BQ25723_ADC_REG_COUNT 4
+
+// ADC conversion mode (ADC_OPTION ADC_CONV)
+enum BQ25723AdcMode : uint8_t {
+    BQ25723_ADC_ONE_SHOT   = 0,
+    BQ25723_ADC_CONTINUOUS = 1
+};
+
+// Charge watchdog timeout (CHARGE_OPTION_0 WDTMR_ADJ)
+enum BQ25723WatchdogTimeout : uint8_t {
+    BQ25723_WATCHDOG_DISABLED = 0,
+    BQ25723_WATCHDOG_5S       = 1,
+    BQ25723_WATCHDOG_88S      = 2,
+    BQ25723_WATCHDOG_175S     = 3
+};
+
+// Scaled ADC results, all sampled in one burst read
+struct BQ25723AdcReading {
+    uint16_t vbus_mV;
+    uint16_t psys_mV;    // Voltage on the PSYS pin
+    uint16_t ichg_mA;
+    uint16_t idchg_mA;
+    uint16_t iin_mA;
+    uint16_t cmpin_mV;
+    uint16_t vsys_mV;
+    uint16_t vbat_mV;
+};
+
+// Number of registers in a telemetry burst (CHARGER_STATUS through ADCVSYSVBAT)
+#define BQ25723_TELEMETRY_REG_COUNT 7
+
+// Status and ADC results captured by one burst read
+struct BQ25723Telemetry {
+    uint16_t chargerStatus;
+    uint16_t prochotStatus;
+    uint16_t iinDpm_mA;
+    BQ25723AdcReading adc;
+};
+
+// Number of writable configuration registers (0x00-0x0E and 0x30-0x3E)
+#define BQ25723_CONFIG_REG_COUNT 16
+
+// Writable configuration, as captured by saveConfig()
+struct BQ25723Config {
+    uint16_t validMask;                         // Bit i set if words[i] was read
+    uint16_t words[BQ25723_CONFIG_REG_COUNT];   // 0x00-0x0E, then 0x30-0x3E
+    
+    /**
+     * Get the register address of a configuration slot
+     * @param index Slot index (0 to BQ25723_CONFIG_REG_COUNT - 1)
+     * @return Register address
+     */
+    static uint8_t address(uint8_t index) {
+        return (index < BQ25723_CONFIG_REG_COUNT / 2) ? 2 * index
+                                                      : BQ25723_REG_CHARGE_OPTION_1 + 2 * (index - BQ25723_CONFIG_REG_COUNT / 2);
+    }
+};
+
+// One register of a configuration profile: bits under mask are set, the
+// rest keep their current value (a full mask writes without reading)
+struct BQ25723ProfileEntry {
+    uint8_t regAddr;
+    uint16_t mask;
+    uint16_t bits;
+};
+
+// Merge two entries for the same register; mixing registers fails to compile
+inline uint16_t bq25723ProfileRegisterMismatch() {
+    return 0;
+}
+
+constexpr BQ25723ProfileEntry operator|(const BQ25723ProfileEntry& a, const BQ25723ProfileEntry& b) {
+    return (a.regAddr == b.regAddr)
+        ? BQ25723ProfileEntry{ a.regAddr, (uint16_t)(a.mask | b.mask),
+                               (uint16_t)((a.bits & ~b.mask) | b.bits) }
+        : BQ25723ProfileEntry{ a.regAddr, bq25723ProfileRegisterMismatch(), 0 };
+}
+
+/**
+ * Compile-time configuration profile stored in flash
+ * Define one at namespace scope with BQ25723_PROFILE(); every entry is
+ * encoded by the compiler, and applyProfile() only copies words out:
+ *
+ *   BQ25723_PROFILE(kLiIon3S,
+ *       BQ25723Profile::value<BQ25723Fields::CHARGE_CURRENT>(2048),
+ *       BQ25723Profile::value<BQ25723Fields::CHARGE_VOLTAGE>(12600),
+ *       BQ25723Profile::value<BQ25723Fields::IIN_HOST>(3000));
+ */
+struct BQ25723Profile {
+    const BQ25723ProfileEntry* entries;   // PROGMEM, ascending addresses
+    uint8_t count;
+    
+    // Field set to a physical value (mV or mA), rounded down
+    template <typename Field>
+    static constexpr BQ25723ProfileEntry value(uint16_t value) {
+        return code<Field>(Field::fromValue(value));
+    }
+    
+    // Field set to a raw code
+    template <typename Field>
+    static constexpr BQ25723ProfileEntry code(uint16_t code) {
+        static_assert(!Field::reg::readOnly, "Profile entry targets a read-only register");
+        return BQ25723ProfileEntry{ Field::reg::address, Field::mask, Field::encode(code) };
+    }
+    
+    // Whole register word
+    template <typename Reg>
+    static constexpr BQ25723ProfileEntry word(uint16_t value) {
+        static_assert(!Reg::readOnly, "Profile entry targets a read-only register");
+        return BQ25723ProfileEntry{ Reg::address, 0xFFFF, value };
+    }
+    
+    // Check that addresses strictly ascend (one entry per register)
+    static constexpr bool sorted(const BQ25723ProfileEntry* entries, uint8_t count) {
+        return count < 2 || (entries[0].regAddr < entries[1].regAddr && sorted(entries + 1, count - 1));
+    }
+};
+
+#define BQ25723_PROFILE(name, ...) \
+    constexpr BQ25723ProfileEntry name##Entries[] PROGMEM = { __VA_ARGS__ }; \
+    static_assert(BQ25723Profile::sorted(name##Entries, sizeof(name##Entries) / sizeof(name##Entries[0])), \
+                  #name ": entries must ascend by address, one per register (merge fields with |)"); \
+    constexpr BQ25723Profile name = { name##Entries, sizeof(name##Entries) / sizeof(name##Entries[0]) }
+
+// Values of every register slot, as captured by readRegisterMap()
+struct BQ25723RegisterMap {
+    uint32_t validMask;                  // Bit n set if words[n] was read
+    uint16_t words[BQ25723_REG_COUNT];   // words[n] holds address 2 * n
+};
+
+/**
+ * Single-writer sequence lock
+ * Readers copy the value without blocking and retry if a publish raced
+ * with the copy; they never wait on the writer's I2C traffic.
+ */
+template <typename T>
+class BQ25723SeqLock {
+private:
+    uint32_t _sequence;   // Odd while a publish is in progress
+    T _value;
+    
+public:
+    BQ25723SeqLock() : _sequence(0), _value() {}
+    
+    /**
+     * Publish a new value (one writer at a time)
+     * @param value Value to publish
+     */
+    void publish(const T& value) {
+        uint32_t seq = __atomic_load_n(&_sequence, __ATOMIC_RELAXED);
+        __atomic_store_n(&_sequence, seq + 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        _value = value;
+        __atomic_store_n(&_sequence, seq + 2, __ATOMIC_RELEASE);
+    }
+    
+    /**
+     * Copy the latest published value
+     * @param value Pointer to store the copy
+     * @return Sequence number of the copy (even, 0 if nothing was published)
+     */
+    uint32_t read(T* value) const {
+        uint32_t before, after;
+        do {
+            before = __atomic_load_n(&_sequence, __ATOMIC_ACQUIRE);
+            if (before & 1) continue;
+            *value = _value;
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            after = __atomic_load_n(&_sequence, __ATOMIC_RELAXED);
+        } while ((before & 1) || before != after);
+        return before;
+    }
+    
+    /**
+     * Get the current sequence number without copying
+     * @return Sequence number (even when stable, 0 if nothing was published)
+     */
+    uint32_t sequence() const {
+        return __atomic_load_n(&_sequence, __ATOMIC_ACQUIRE);
+    }
+};
+
+/**
+ * I2C transport used by the driver for every bus transaction
+ * Register transfers hand over the caller's buffer, so a backend can move
+ * data directly between it and the bus. Results are BQ25723BusStatus codes.
+ */
+class BQ25723Transport {
+public:
+    virtual ~BQ25723Transport() {}
+    
+    /**
+     * Initialize the bus peripheral
+     * @param sdaPin SDA pin (-1 uses default pins)
+     * @param sclPin SCL pin (-1 uses default pins)
+     * @return true if the bus is ready
+     */
+    virtual bool begin(int sdaPin, int sclPin) = 0;
+    
+    /**
+     * Change the bus clock rate
+     * @param hz Clock rate in Hz
+     */
+    virtual void setClock(uint32_t hz) = 0;
+    
+    /**
+     * Address a device without transferring data
+     * @param address 7-bit I2C address
+     * @return Bus status
+     */
+    virtual uint8_t probe(uint8_t address) = 0;
+    
+    /**
+     * Write a register pointer, then read with a repeated start
+     * @param address 7-bit I2C address
+     * @param regAddr Register pointer
+     * @param data Buffer receiving length bytes
+     * @param length Number of bytes to read
+     * @return Bus status
+     */
+    virtual uint8_t read(uint8_t address, uint8_t regAddr, uint8_t* data, uint8_t length) = 0;
+    
+    /**
+     * Write a register pointer followed by data in one transaction
+     * @param address 7-bit I2C address
+     * @param regAddr Register pointer
+     * @param data Bytes to write
+     * @param length Number of bytes to write
+     * @return Bus status
+     */
+    virtual uint8_t write(uint8_t address, uint8_t regAddr, const uint8_t* data, uint8_t length) = 0;
+    
+    /**
+     * Free a stuck bus and reinitialize the peripheral
+     * Backends that can drive the pins clock SCL until a slave holding SDA
+     * low releases it. The clock rate is restored by the caller afterwards.
+     * @return true if the bus is idle afterwards; false if it is still held
+     *         or the backend cannot recover (the default)
+     */
+    virtual bool recover() {
+        return false;
+    }
+};
+
+// Transport over an Arduino TwoWire instance
+class BQ25723WireTransport : public BQ25723Transport {
+private:
+    TwoWire* _wire;
+    int _sdaPin;    // Pins from begin(), -1 for the board defaults
+    int _sclPin;
+    
+public:
+    explicit BQ25723WireTransport(TwoWire* wire = &Wire) : _wire(wire), _sdaPin(-1), _sclPin(-1) {}
+    
+    bool begin(int sdaPin, int sclPin) override {
+        _sdaPin = sdaPin;
+        _sclPin = sclPin;
+        if (sdaPin >= 0 && sclPin >= 0) {
+            _wire->begin(sdaPin, sclPin);
+        } else {
+            _wire->begin();
+        }
+        return true;
+    }
+    
+    void setClock(uint32_t hz) override {
+        _wire->setClock(hz);
+    }
+    
+    uint8_t probe(uint8_t address) override {
+        _wire->beginTransmission(address);
+        return _wire->endTransmission();
+    }
+    
+    uint8_t read(uint8_t address, uint8_t regAddr, uint8_t* data, uint8_t length) override {
+        // Send register address
+        _wire->beginTransmission(address);
+        _wire->write(regAddr);
+        uint8_t status = _wire->endTransmission(false);
+        if (status != BQ25723_BUS_OK) {
+            return status;
+        }
+        
+        if (_wire->requestFrom(address, length) != length) {
+            return BQ25723_BUS_SHORT_READ;
+        }
+        for (uint8_t i = 0; i < length; i++) {
+            data[i] = _wire->read();
+        }
+        return BQ25723_BUS_OK;
+    }
+    
+    uint8_t write(uint8_t address, uint8_t regAddr, const uint8_t* data, uint8_t length) override {
+        _wire->beginTransmission(address);
+        _wire->write(regAddr);
+        _wire->write(data, length);
+        return _wire->endTransmission(true);
+    }
+    
+    bool recover() override {
+        _wire->end();
+        bool idle = clearBus(_sdaPin, _sclPin);
+        begin(_sdaPin, _sclPin);
+        return idle;
+    }
+    
+    /**
+     * Bus clear as in the I2C specification (UM10204 3.1.16): up to nine
+     * SCL pulses while SDA is held low, then a STOP
+     * The pins are driven open-drain by switching between OUTPUT LOW and
+     * INPUT_PULLUP; end the TwoWire peripheral first and begin it afterwards.
+     * @param sdaPin SDA pin, -1 for the board default
+     * @param sclPin SCL pin, -1 for the board default
+     * @return true if both lines are high afterwards
+     */
+    static bool clearBus(int sdaPin, int sclPin) {
+        int sda = (sdaPin >= 0 && sclPin >= 0) ? sdaPin : SDA;
+        int scl = (sdaPin >= 0 && sclPin >= 0) ? sclPin : SCL;
+        
+        pinMode(sda, INPUT_PULLUP);
+        pinMode(scl, INPUT_PULLUP);
+        delayMicroseconds(5);
+        for (uint8_t i = 0; i < 9 && digitalRead(sda) == LOW; i++) {
+            digitalWrite(scl, LOW);
+            pinMode(scl, OUTPUT);
+            delayMicroseconds(5);
+            pinMode(scl, INPUT_PULLUP);
+            delayMicroseconds(5);
+        }
+        
+        // STOP: SDA rises while SCL is high
+        digitalWrite(sda, LOW);
+        pinMode(sda, OUTPUT);
+        delayMicroseconds(5);
+        pinMode(sda, INPUT_PULLUP);
+        delayMicroseconds(5);
+        return digitalRead(sda) == HIGH && digitalRead(scl) == HIGH;
+    }
+    
+    /**
+     * Get the underlying TwoWire instance
+     * @return TwoWire pointer
+     */
+    TwoWire* getWire() const {
+        return _wire;
+    }
+};
 
 class BQ25723 {
 private:
     uint8_t _address;
-    TwoWire* _wire;
+    BQ25723WireTransport _wireTransport;   // Used by the TwoWire constructor
+    BQ25723Transport* _transport;
     uint32_t _i2cSpeed;
     bool _initialized;
+    uint8_t _lastStatus;            // BQ25723BusStatus of the last transaction
+    
+    // Clock negotiation: fall back to slower rates after repeated failures
+    bool _clockNegotiated;
+    uint8_t _failureCount;
+    
+    // Bus recovery: recover() runs automatically on bus errors when enabled
+    bool _autoRecover;
+    bool _recovering;               // Set while recover() runs, blocks re-entry
+    bool _linkDown;                 // Last recovery failed; retried after _linkRetryMs
+    uint32_t _linkRetryMs;
+    uint32_t _linkBackoffMs;
+    uint16_t _recoveryCount;
+    
+    // Shadow copy of non-volatile registers, one slot per even address
+    bool _cacheEnabled;
+    uint32_t _cacheValid;
+    uint16_t _cache[BQ25723_REG_COUNT];
+    
+    // Watchdog keep-alive: any write to CHARGE_CURRENT or CHARGE_VOLTAGE
+    // resets the device timer
+    uint32_t _watchdogPeriodMs;     // 0 while the service is off
+    uint32_t _watchdogKickMs;       // millis() of the last resetting write
+    uint8_t _watchdogKnown;         // Bit 0: CHARGE_CURRENT, bit 1: CHARGE_VOLTAGE
+    uint16_t _watchdogWords[2];     // Last values seen for those registers
+    
+#if BQ25723_THREAD_SAFE
+    // Recursive so composite operations (updateBits, bursts) hold it once
+    mutable StaticSemaphore_t _mutexBuffer;
+    mutable SemaphoreHandle_t _mutex;
+    
+    // Writer-side copy of the latest telemetry and its lock-free publisher
+    BQ25723Telemetry _telemetry;
+    BQ25723SeqLock<BQ25723Telemetry> _published;
+#endif
+    
+    // Holds the bus mutex for its scope (no-op unless BQ25723_THREAD_SAFE)
+    class Guard {
+    public:
+#if BQ25723_THREAD_SAFE
+        explicit Guard(const BQ25723& owner) : _mutex(owner._mutex) {
+            xSemaphoreTakeRecursive(_mutex, portMAX_DELAY);
+        }
+        ~Guard() {
+            xSemaphoreGiveRecursive(_mutex);
+        }
+    private:
+        SemaphoreHandle_t _mutex;
+#else
+        explicit Guard(const BQ25723&) {}
+#endif
+    };
+    
+    // Helper function to check if communication is working
+    bool checkCommunication() {
+        return (_transport->probe(_address) == BQ25723_BUS_OK);
+    }
+    
+    // Addresses of every register in the map, in ascending order
+    typedef uint8_t RegisterAddressTable[
+#define BQ25723_X_COUNT(name, addr, flags) + 1
+        0 BQ25723_REGISTER_MAP(BQ25723_X_COUNT)
+#undef BQ25723_X_COUNT
+    ];
+    static const RegisterAddressTable& registerAddresses() {
+        static const RegisterAddressTable table PROGMEM = {
+#define BQ25723_X_TABLE(name, addr, flags) addr,
+            BQ25723_REGISTER_MAP(BQ25723_X_TABLE)
+#undef BQ25723_X_TABLE
+        };
+        return table;
+    }
+    
+    // Register name at an address, folded from the map at compile time
+    static constexpr const char* registerNameAt(uint8_t regAddr) {
+        return
+#define BQ25723_X_NAME_AT(name, addr, flags) (regAddr == addr) ? #name :
+            BQ25723_REGISTER_MAP(BQ25723_X_NAME_AT)
+#undef BQ25723_X_NAME_AT
+            "UNKNOWN";
+    }
+    
+    // Name pointers for every address 0x00-0x3F, indexed directly
+    static const char* const* registerNames() {
+#define BQ25723_NAME_ROW(a) registerNameAt(a), registerNameAt(a + 1), registerNameAt(a + 2), registerNameAt(a + 3), \
+                            registerNameAt(a + 4), registerNameAt(a + 5), registerNameAt(a + 6), registerNameAt(a + 7)
+        static const char* const table[BQ25723_NAME_TABLE_SIZE] PROGMEM = {
+            BQ25723_NAME_ROW(0x00), BQ25723_NAME_ROW(0x08), BQ25723_NAME_ROW(0x10), BQ25723_NAME_ROW(0x18),
+            BQ25723_NAME_ROW(0x20), BQ25723_NAME_ROW(0x28), BQ25723_NAME_ROW(0x30), BQ25723_NAME_ROW(0x38)
+        };
+#undef BQ25723_NAME_ROW
+        return table;
+    }
+    
+    // FNV-1a over the upper-cased name; the constexpr and runtime forms match
+    static constexpr uint32_t nameHash(const char* s, uint32_t h = 2166136261UL) {
+        return *s ? nameHash(s + 1, (h ^ (uint8_t)((*s >= 'a' && *s <= 'z') ? *s - 32 : *s)) * 16777619UL) : h;
+    }
+    
+    static uint32_t runtimeNameHash(const char* s) {
+        uint32_t h = 2166136261UL;
+        for (; *s; s++) {
+            uint8_t c = (uint8_t)*s;
+            if (c >= 'a' && c <= 'z') c -= 32;
+            h = (h ^ c) * 16777619UL;
+        }
+        return h;
+    }
+    
+    static bool namesEqual(const char* a, const char* b) {
+        for (; *a && *b; a++, b++) {
+            char ca = (*a >= 'a' && *a <= 'z') ? *a - 32 : *a;
+            if (ca != *b) return false;
+        }
+        return *a == *b;
+    }
+    
+    // Append "0xHH" / "0xHHHH" using a nibble table (no printf)
+    static char* formatHex(char* p, uint16_t value, uint8_t digits) {
+        static const char hex[] = "0123456789ABCDEF";
+        *p++ = '0';
+        *p++ = 'x';
+        while (digits--) {
+            *p++ = hex[(value >> (4 * digits)) & 0x0F];
+        }
+        return p;
+    }
+    
+    // Format one dump line; returns its length
+    static uint8_t formatRegisterLine(char* line, const BQ25723RegisterMap& map, uint8_t regAddr) {
+        bool valid = (map.validMask & (1UL << (regAddr >> 1))) != 0;
+        uint16_t value = map.words[regAddr >> 1];
+        
+        // The ID word holds two 8-bit registers
+        bool byteRegister = (regAddr & 1) || regAddr == BQ25723_REG_MANUFACTURER_ID;
+        if (byteRegister) {
+            value = (regAddr & 1) ? (value >> 8) : (value & 0xFF);
+        }
+        
+        char* p = formatHex(line, regAddr, 2);
+        *p++ = ' ';
+        *p++ = '(';
+        for (const char* name = getRegisterName(regAddr); *name; name++) {
+            *p++ = *name;
+        }
+        *p++ = ')';
+        *p++ = ':';
+        *p++ = ' ';
+        if (valid) {
+            p = formatHex(p, value, byteRegister ? 2 : 4);
+        } else {
+            for (uint8_t i = 0; i < 6; i++) *p++ = '-';
+        }
+        *p++ = '\r';
+        *p++ = '\n';
+        return p - line;
+    }
+    
+    // Check if a register is served from the shadow cache
+    bool isCacheable(uint8_t regAddr) const {
+        return _cacheEnabled && !(regAddr & 1) && regAddr < 2 * BQ25723_REG_COUNT &&
+               !isVolatileRegister(regAddr);
+    }
+    
+    // Record a value read back from the device
+    void cacheStore(uint8_t regAddr, uint16_t value) {
+        if (!isCacheable(regAddr)) return;
+        _cache[regAddr >> 1] = value;
+        _cacheValid |= (1UL << (regAddr >> 1));
+    }
+    
+    static uint32_t watchdogPeriodMs(uint8_t timeout) {
+        switch (timeout) {
+            case BQ25723_WATCHDOG_5S:   return 5000;
+            case BQ25723_WATCHDOG_88S:  return 88000;
+            case BQ25723_WATCHDOG_175S: return 175000;
+            default:                    return 0;
+        }
+    }
+    
+    bool watchdogElapsed(uint8_t percent) const {
+        return _watchdogPeriodMs &&
+               (millis() - _watchdogKickMs) >= _watchdogPeriodMs / 100 * percent;
+    }
+    
+    // Track CHARGE_CURRENT/CHARGE_VOLTAGE values (and timer resets) seen in a
+    // transfer of count words starting at regAddr
+    void noteWatchdogWords(uint8_t regAddr, const uint16_t* words, uint8_t count, bool written) {
+        for (uint8_t i = 0; i < count; i++) {
+            uint8_t addr = regAddr + 2 * i;
+            if (addr == BQ25723_REG_CHARGE_CURRENT || addr == BQ25723_REG_CHARGE_VOLTAGE) {
+                uint8_t slot = (addr == BQ25723_REG_CHARGE_VOLTAGE);
+                _watchdogWords[slot] = words[i];
+                _watchdogKnown |= (1 << slot);
+                if (written) _watchdogKickMs = millis();
+            } else if (addr == BQ25723_REG_CHARGE_OPTION_0 && written && _watchdogPeriodMs) {
+                _watchdogPeriodMs = watchdogPeriodMs(BQ25723Fields::WDTMR_ADJ::get(words[i]));
+            }
+        }
+    }
+    
+    // Raw read of consecutive 16-bit registers in one transaction, relying on
+    // the device auto-incrementing the register pointer after every byte.
+    // The device sends LSB first, so on little-endian targets the bytes land
+    // in the word buffer without conversion.
+    uint8_t busRead(uint8_t regAddr, uint16_t* words, uint8_t count) {
+        uint8_t status = _transport->read(_address, regAddr, reinterpret_cast<uint8_t*>(words), count * 2);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        for (uint8_t i = 0; status == BQ25723_BUS_OK && i < count; i++) {
+            words[i] = (words[i] << 8) | (words[i] >> 8);
+        }
+#endif
+        return status;
+    }
+    
+    // Raw write of consecutive 16-bit registers in one transaction
+    uint8_t busWrite(uint8_t regAddr, const uint16_t* words, uint8_t count) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        uint16_t swapped[BQ25723_BURST_MAX_WRITE_WORDS];
+        if (count > BQ25723_BURST_MAX_WRITE_WORDS) return BQ25723_BUS_DATA_TOO_LONG;
+        for (uint8_t i = 0; i < count; i++) {
+            swapped[i] = (words[i] << 8) | (words[i] >> 8);
+        }
+        words = swapped;
+#endif
+        return _transport->write(_address, regAddr, reinterpret_cast<const uint8_t*>(words), count * 2);
+    }
+    
+    // Track consecutive failures and step a negotiated clock down
+    bool noteBusResult(bool ok) {
+        if (ok) {
+            _failureCount = 0;
+        } else if (++_failureCount >= BQ25723_CLOCK_FALLBACK_FAILURES) {
+            _failureCount = 0;
+            if (_clockNegotiated && _i2cSpeed > BQ25723_I2C_SPEED_STANDARD) {
+                _i2cSpeed = (_i2cSpeed > BQ25723_I2C_SPEED_FAST) ? BQ25723_I2C_SPEED_FAST
+                                                                : BQ25723_I2C_SPEED_STANDARD;
+                _transport->setClock(_i2cSpeed);
+            }
+        }
+        return ok;
+    }
+    
+#if BQ25723_ENABLE_STATS
+    BQ25723BusStats _stats;
+    
+    void recordTransaction(bool write, uint8_t regAddr, uint8_t count,
+                           uint8_t status, uint32_t latencyUs) {
+        uint32_t* perRegister = write ? _stats.writes : _stats.reads;
+        for (uint8_t i = 0; i < count; i++) {
+            uint8_t slot = (regAddr >> 1) + i;
+            if (slot < BQ25723_REG_COUNT) perRegister[slot]++;
+        }
+        
+        _stats.transactions++;
+        _stats.totalLatencyUs += latencyUs;
+        if (latencyUs < _stats.minLatencyUs) _stats.minLatencyUs = latencyUs;
+        if (latencyUs > _stats.maxLatencyUs) _stats.maxLatencyUs = latencyUs;
+        
+        _stats.bytesWritten += write ? 1 + 2 * count : 1;
+        if (status == BQ25723_BUS_OK) {
+            if (!write) _stats.bytesRead += 2 * count;
+        } else {
+            _stats.failures++;
+            if (status == BQ25723_BUS_NACK_ADDRESS || status == BQ25723_BUS_NACK_DATA) _stats.nacks++;
+            if (status == BQ25723_BUS_SHORT_READ) _stats.shortReads++;
+        }
+    }
+#endif
+    
+#if BQ25723_ENABLE_TRACE
+    BQ25723Ring<BQ25723TraceEntry, BQ25723_TRACE_CAPACITY> _trace;
+    
+    static uint8_t putTraceEntry(uint8_t* p, const BQ25723TraceEntry& entry) {
+        p[0] = entry.timestampUs & 0xFF;
+        p[1] = (entry.timestampUs >> 8) & 0xFF;
+        p[2] = (entry.timestampUs >> 16) & 0xFF;
+        p[3] = (entry.timestampUs >> 24) & 0xFF;
+        p[4] = entry.latencyUs & 0xFF;
+        p[5] = entry.latencyUs >> 8;
+        p[6] = entry.value & 0xFF;
+        p[7] = entry.value >> 8;
+        p[8] = entry.regAddr;
+        p[9] = entry.count;
+        p[10] = entry.flags;
+        p[11] = entry.status;
+        return BQ25723_TRACE_ENTRY_SIZE;
+    }
+#endif
+    
+#if BQ25723_ENABLE_STATS || BQ25723_ENABLE_TRACE
+    // Record a finished transaction that started at micros() == start
+    void noteTransaction(bool write, uint8_t regAddr, const uint16_t* words, uint8_t count,
+                         uint8_t status, uint32_t start) {
+        uint32_t latencyUs = micros() - start;
+#if BQ25723_ENABLE_STATS
+        recordTransaction(write, regAddr, count, status, latencyUs);
+#endif
+#if BQ25723_ENABLE_TRACE
+        BQ25723TraceEntry entry;
+        entry.timestampUs = start;
+        entry.latencyUs = latencyUs > 0xFFFF ? 0xFFFF : (uint16_t)latencyUs;
+        entry.value = (write || status == BQ25723_BUS_OK) ? words[0] : 0;
+        entry.regAddr = regAddr;
+        entry.count = count;
+        entry.flags = write ? BQ25723_TRACE_WRITE : 0;
+        entry.status = status;
+        _trace.push(entry);
+#else
+        (void)words;
+#endif
+    }
+#endif
+    
+    // Bus transactions recorded in the statistics and trace when enabled
+    uint8_t busReadNoted(uint8_t regAddr, uint16_t* words, uint8_t count) {
+#if BQ25723_ENABLE_STATS || BQ25723_ENABLE_TRACE
+        uint32_t start = micros();
+        uint8_t status = busRead(regAddr, words, count);
+        noteTransaction(false, regAddr, words, count, status, start);
+        return status;
+#else
+        return busRead(regAddr, words, count);
+#endif
+    }
+    
+    uint8_t busWriteNoted(uint8_t regAddr, const uint16_t* words, uint8_t count) {
+#if BQ25723_ENABLE_STATS || BQ25723_ENABLE_TRACE
+        uint32_t start = micros();
+        uint8_t status = busWrite(regAddr, words, count);
+        noteTransaction(true, regAddr, words, count, status, start);
+        return status;
+#else
+        return busWrite(regAddr, words, count);
+#endif
+    }
+    
+    // Bus transactions used by the public API
+    bool readWords(uint8_t regAddr, uint16_t* words, uint8_t count) {
+        Guard guard(*this);
+        if (_linkDown && !restoreLink()) {
+            _lastStatus = BQ25723_BUS_NOT_READY;
+            return false;
+        }
+        uint8_t status = busReadNoted(regAddr, words, count);
+        if (status != BQ25723_BUS_OK && autoRecover(status)) {
+            status = busReadNoted(regAddr, words, count);
+        }
+        _lastStatus = status;
+        if (status == BQ25723_BUS_OK) {
+            _linkDown = false;
+            noteWatchdogWords(regAddr, words, count, false);
+        }
+        return noteBusResult(status == BQ25723_BUS_OK);
+    }
+    
+    bool writeWords(uint8_t regAddr, const uint16_t* words, uint8_t count) {
+        Guard guard(*this);
+        if (_linkDown && !restoreLink()) {
+            _lastStatus = BQ25723_BUS_NOT_READY;
+            return false;
+        }
+        
+        // Once the keep-alive is due, extend a write ending just below
+        // CHARGE_CURRENT or starting just above CHARGE_VOLTAGE to rewrite it
+        uint16_t extended[BQ25723_BURST_MAX_WRITE_WORDS];
+        if (count < BQ25723_BURST_MAX_WRITE_WORDS && watchdogElapsed(BQ25723_WATCHDOG_PIGGYBACK_PCT)) {
+            if (regAddr + 2 * count == BQ25723_REG_CHARGE_CURRENT && (_watchdogKnown & 1)) {
+                memcpy(extended, words, 2 * count);
+                extended[count++] = _watchdogWords[0];
+                words = extended;
+            } else if (regAddr == BQ25723_REG_CHARGE_VOLTAGE + 2 && (_watchdogKnown & 2)) {
+                extended[0] = _watchdogWords[1];
+                memcpy(&extended[1], words, 2 * count);
+                words = extended;
+                count++;
+                regAddr = BQ25723_REG_CHARGE_VOLTAGE;
+            }
+        }
+        
+        for (uint8_t i = 0; i < count; i++) {
+            invalidateCache(regAddr + 2 * i);
+        }
+        uint8_t status = busWriteNoted(regAddr, words, count);
+        if (status != BQ25723_BUS_OK && autoRecover(status)) {
+            status = busWriteNoted(regAddr, words, count);
+        }
+        _lastStatus = status;
+        if (status == BQ25723_BUS_OK) {
+            _linkDown = false;
+            noteWatchdogWords(regAddr, words, count, true);
+            
+            // The device now holds the written words, unless a register reset
+            // returned every register to its default
+            for (uint8_t i = 0; i < count; i++) {
+                uint8_t addr = regAddr + 2 * i;
+                if (addr == BQ25723_REG_CHARGE_OPTION_3 && BQ25723Fields::RESET_REG::get(words[i])) {
+                    invalidateCache();
+                    break;
+                }
+                cacheStore(addr, words[i]);
+            }
+        }
+        return noteBusResult(status == BQ25723_BUS_OK);
+    }
+    
+    // Bits first to first + length - 1 of a 32-slot validity mask
+    static uint32_t slotMask(uint8_t first, uint8_t length) {
+        if (first >= 32) return 0;
+        uint8_t end = (first + length < 32) ? first + length : 32;
+        uint32_t below = (end == 32) ? 0xFFFFFFFFUL : (1UL << end) - 1;
+        return below & ~((1UL << first) - 1);
+    }
+    
+    // One burst of a batch read; with preserve set, a failed burst leaves
+    // the caller's buffer untouched
+    uint8_t readChunk(uint8_t regAddr, uint16_t* buffer, uint8_t count, bool preserve) {
+        uint16_t scratch[BQ25723_BURST_MAX_WORDS];
+        uint16_t* words = preserve ? scratch : buffer;
+        if (!readWords(regAddr, words, count)) {
+            return _lastStatus;
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            buffer[i] = words[i];
+            cacheStore(regAddr + 2 * i, words[i]);
+        }
+        return BQ25723_BUS_OK;
+    }
+    
+    // Run recover() after a failure that points at the bus rather than the
+    // device (a NACK means it is absent or busy, so retrying cannot help)
+    bool autoRecover(uint8_t status) {
+        if (!_autoRecover || _recovering) return false;
+        if (status != BQ25723_BUS_ERROR && status != BQ25723_BUS_TIMEOUT &&
+            status != BQ25723_BUS_SHORT_READ) {
+            return false;
+        }
+        return recover();
+    }
+    
+    // Called before each transaction while the link is down: with
+    // auto-recovery on, fail fast until the retry time, then recover again
+    bool restoreLink() {
+        if (!_autoRecover || _recovering) return true;
+        if ((int32_t)(millis() - _linkRetryMs) < 0) return false;
+        return recover();
+    }
+    
+    // Configuration slots held in the shadow cache
+    void cachedConfig(BQ25723Config* config) const {
+        config->validMask = 0;
+        for (uint8_t i = 0; i < BQ25723_CONFIG_REG_COUNT; i++) {
+            uint8_t slot = BQ25723Config::address(i) >> 1;
+            config->words[i] = _cache[slot];
+            if (_cacheValid & (1UL << slot)) config->validMask |= (1U << i);
+        }
+    }
+    
+    // Write the valid slots of config that current does not already hold,
+    // as consecutive runs in address order
+    bool writeConfigChanges(const BQ25723Config& config, const BQ25723Config& current, uint8_t* written) {
+        const uint8_t half = BQ25723_CONFIG_REG_COUNT / 2;
+        uint16_t changed = config.validMask;
+        for (uint8_t i = 0; i < BQ25723_CONFIG_REG_COUNT; i++) {
+            if ((current.validMask & (1U << i)) && current.words[i] == config.words[i]) {
+                changed &= ~(1U << i);
+            }
+        }
+        
+        // Runs never span the two halves, which are not adjacent on the bus
+        bool ok = true;
+        for (uint8_t i = 0; i < BQ25723_CONFIG_REG_COUNT; ) {
+            if (!(changed & (1U << i))) {
+                i++;
+                continue;
+            }
+            uint8_t length = 1;
+            while (i + length < BQ25723_CONFIG_REG_COUNT && i + length != half &&
+                   (changed & (1U << (i + length)))) {
+                length++;
+            }
+            uint8_t count = writeMultipleRegisters(BQ25723Config::address(i), &config.words[i], length);
+            if (written) *written += count;
+            ok &= (count == length);
+            i += length;
+        }
+        return ok;
+    }
+    
+    // Shared constructor body
+    void init(uint32_t i2cSpeed) {
+        _i2cSpeed = i2cSpeed;
+        _initialized = false;
+        _lastStatus = BQ25723_BUS_NOT_READY;
+        _clockNegotiated = false;
+        _failureCount = 0;
+        _autoRecover = false;
+        _recovering = false;
+        _linkDown = false;
+        _linkRetryMs = 0;
+        _linkBackoffMs = BQ25723_RECOVERY_RETRY_MS;
+        _recoveryCount = 0;
+        _cacheEnabled = false;
+        _cacheValid = 0;
+        _watchdogPeriodMs = 0;
+        _watchdogKickMs = 0;
+        _watchdogKnown = 0;
+#if BQ25723_THREAD_SAFE
+        _mutex = xSemaphoreCreateRecursiveMutexStatic(&_mutexBuffer);
+        memset(&_telemetry, 0, sizeof(_telemetry));
+#endif
+#if BQ25723_ENABLE_STATS
+        resetStats();
+#endif
+    }
+    
+    // Check that the ID word reads back as expected at the current clock
+    bool probeClock(uint16_t expectedId) {
+        for (uint8_t i = 0; i < BQ25723_CLOCK_PROBE_READS; i++) {
+            uint16_t id;
+            if (busRead(BQ25723_REG_MANUFACTURER_ID, &id, 1) != BQ25723_BUS_OK || id != expectedId) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+public:
+    /**
+     * Constructor
+     * @param address I2C address (default 0x6B)
+     * @param wire TwoWire instance to use (default &Wire)
+     * @param i2cSpeed I2C clock speed in Hz (default 100000)
+     */
+    BQ25723(uint8_t address = BQ25723_I2C_ADDR_DEFAULT, 
+            TwoWire* wire = &Wire, 
+            uint32_t i2cSpeed = 100000) 
+        : _address(address), _wireTransport(wire), _transport(&_wireTransport) {
+        init(i2cSpeed);
+    }
+    
+    /**
+     * Constructor for a custom transport
+     * @param transport Transport to use; must outlive the driver
+     * @param address I2C address (default 0x6B)
+     * @param i2cSpeed I2C clock speed in Hz (default 100000)
+     */
+    explicit BQ25723(BQ25723Transport& transport,
+                     uint8_t address = BQ25723_I2C_ADDR_DEFAULT,
+                     uint32_t i2cSpeed = 100000)
+        : _address(address), _transport(&transport) {
+        init(i2cSpeed);
+    }
+    
+    BQ25723(const BQ25723&) = delete;
+    BQ25723& operator=(const BQ25723&) = delete;
+    
+    /**
+     * Get the transport carrying this driver's transactions
+     * @return Transport reference
+     */
+    BQ25723Transport& getTransport() const {
+        return *_transport;
+    }
+    
+    /**
+     * Initialize the BQ25723 communication
+     * @param sdaPin SDA pin (default -1 uses default pins)
+     * @param sclPin SCL pin (default -1 uses default pins)
+     * @param maxI2cSpeed When non-zero, negotiate the fastest clock rate up to
+     *                    this value (see negotiateClock())
+     * @return true if device is detected, false otherwise
+     */
+    bool begin(int sdaPin = -1, int sclPin = -1, uint32_t maxI2cSpeed = 0) {
+        _transport->begin(sdaPin, sclPin);
+        _transport->setClock(_i2cSpeed);
+        
+        // Check if device is present
+        if (!isConnected()) {
+            _initialized = false;
+            return false;
+        }
+        
+        _initialized = true;
+        _linkDown = false;
+        
+        if (maxI2cSpeed > _i2cSpeed) {
+            negotiateClock(maxI2cSpeed);
+        }
+        return true;
+    }
+    
+    /**
+     * Find the fastest reliable clock rate
+     * Reads the MANUFACTURER_ID/DEVICE_ID word at the current rate, then tries
+     * 400 kHz and 1 MHz in turn, keeping each rate only if repeated reads
+     * match. While a negotiated rate is in use, repeated failed transactions
+     * step the clock back down automatically.
+     * @param maxI2cSpeed Highest clock rate to try in Hz
+     * @return Selected clock rate in Hz, or 0 if the device did not respond
+     */
+    uint32_t negotiateClock(uint32_t maxI2cSpeed = BQ25723_I2C_SPEED_FAST_PLUS) {
+        Guard guard(*this);
+        if (!_initialized) return 0;
+        
+        uint16_t expectedId;
+        if (busRead(BQ25723_REG_MANUFACTURER_ID, &expectedId, 1) != BQ25723_BUS_OK) {
+            return 0;
+        }
+        
+        static const uint32_t rates[] = { BQ25723_I2C_SPEED_FAST, BQ25723_I2C_SPEED_FAST_PLUS };
+        for (uint8_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+            if (rates[i] <= _i2cSpeed || rates[i] > maxI2cSpeed) continue;
+            
+            _transport->setClock(rates[i]);
+            if (!probeClock(expectedId)) {
+                break;
+            }
+            _i2cSpeed = rates[i];
+        }
+        
+        _transport->setClock(_i2cSpeed);
+        _clockNegotiated = true;
+        _failureCount = 0;
+        return _i2cSpeed;
+    }
+    
+    /**
+     * Get the I2C clock rate in use
+     * @return Clock rate in Hz
+     */
+    uint32_t getI2cSpeed() const {
+        return _i2cSpeed;
+    }
+    
+    /**
+     * Start communication on a bus that is already initialized
+     * Unlike begin(), the TwoWire peripheral and its clock are left untouched,
+     * so several devices can share one bus owner.
+     * @return true if device is detected, false otherwise
+     */
+    bool attach() {
+        _initialized = isConnected();
+        _linkDown = false;
+        return _initialized;
+    }
+    
+    /**
+     * Recover from a stuck or unresponsive bus
+     * Each attempt has the transport free the bus and reinitialize its
+     * peripheral (see BQ25723Transport::recover()), restores the clock rate
+     * and probes the device; attempts are spaced by a doubling backoff. Once
+     * the device answers, the configuration registers are read back and any
+     * that differ from config are rewritten, in case the charger reset. If
+     * it never answers, an attached driver stays initialized with the link
+     * marked down (see isLinkDown()).
+     * @param config Configuration to restore, or nullptr for the registers
+     *               held in the shadow cache
+     * @param written Optional pointer receiving the number of registers written
+     * @return true if the device answers and holds the configuration
+     */
+    bool recover(const BQ25723Config* config = nullptr, uint8_t* written = nullptr) {
+        if (written) *written = 0;
+        
+        Guard guard(*this);
+        if (_recovering) return false;
+        _recovering = true;
+        
+        // Capture the cache before it is invalidated below
+        BQ25723Config cached;
+        if (!config) {
+            cachedConfig(&cached);
+            config = &cached;
+        }
+        
+        bool connected = false;
+        uint32_t backoffMs = BQ25723_RECOVERY_BACKOFF_MS;
+        for (uint8_t attempt = 0; attempt < BQ25723_RECOVERY_ATTEMPTS && !connected; attempt++) {
+            if (attempt) {
+                delay(backoffMs);
+                backoffMs *= 2;
+            }
+            _transport->recover();
+            _transport->setClock(_i2cSpeed);
+            connected = checkCommunication();
+        }
+        
+        // An attached driver stays initialized when recovery fails; the link
+        // is marked down and recovered again on a later access
+        _initialized = _initialized || connected;
+        _failureCount = 0;
+        invalidateCache();
+        if (connected) {
+            _linkDown = false;
+            _linkBackoffMs = BQ25723_RECOVERY_RETRY_MS;
+        } else if (_initialized) {
+            _linkDown = true;
+            _linkRetryMs = millis() + _linkBackoffMs;
+            _linkBackoffMs = (_linkBackoffMs < BQ25723_RECOVERY_RETRY_MAX_MS / 2) ? 2 * _linkBackoffMs
+                                                                                 : BQ25723_RECOVERY_RETRY_MAX_MS;
+        }
+        
+        bool ok = connected;
+        if (connected) {
+            _recoveryCount++;
+            if (config->validMask) {
+                BQ25723Config current;
+                saveConfig(&current);
+                ok = writeConfigChanges(*config, current, written);
+            }
+        }
+        _recovering = false;
+        return ok;
+    }
+    
+    /**
+     * Run recover() automatically when a transaction fails with a bus error,
+     * timeout or short read, then retry that transaction once
+     * Recovery blocks for up to the full backoff schedule. Leave it off for
+     * chargers on a BQ25723Bus, which recovers the shared bus itself.
+     * @param enable true to enable (default off)
+     */
+    void setAutoRecover(bool enable) {
+        _autoRecover = enable;
+    }
+    
+    /**
+     * Get the number of successful recoveries
+     * @return Count since construction
+     */
+    uint16_t getRecoveryCount() const {
+        return _recoveryCount;
+    }
+    
+    /**
+     * Check if the link is down after a failed recovery
+     * With auto-recovery on, accesses fail with BQ25723_BUS_NOT_READY and no
+     * bus traffic until the retry time (BQ25723_RECOVERY_RETRY_MS, doubling),
+     * when the next access runs recover() again. Any successful transaction
+     * brings the link back up.
+     * @return true while the link is down
+     */
+    bool isLinkDown() const {
+        return _linkDown;
+    }
+    
+    /**
+     * Check if device is connected and responding
+     * @return true if device ACKs, false otherwise
+     */
+    bool isConnected() {
+        return checkCommunication();
+    }
+    
+    /**
+     * Read a 16-bit register
+     * @param regAddr Register address to read
+     * @param value Pointer to store the read value
+     * @return true if read successful, false otherwise
+     */
+    bool readRegister(uint8_t regAddr, uint16_t* value) {
+        if (!_initialized || !value) return false;
+        
+        Guard guard(*this);
+        if (isCacheable(regAddr) && (_cacheValid & (1UL << (regAddr >> 1)))) {
+            *value = _cache[regAddr >> 1];
+            return true;
+        }
+        
+        if (!readWords(regAddr, value, 1)) {
+            return false;
+        }
+        
+        cacheStore(regAddr, *value);
+        return true;
+    }
+    
+    /**
+     * Read a 16-bit register, keeping the bus status
+     * @param regAddr Register address to read
+     * @return Value and status; value is meaningful only if ok()
+     */
+    BQ25723Result readRegisterResult(uint8_t regAddr) {
+        BQ25723Result result;
+        result.value = 0;
+        if (!_initialized) {
+            result.status = BQ25723_BUS_NOT_READY;
+        } else {
+            Guard guard(*this);
+            result.status = readRegister(regAddr, &result.value) ? (uint8_t)BQ25723_BUS_OK : _lastStatus;
+        }
+        return result;
+    }
+    
+    /**
+     * Read a 16-bit register (convenience overload)
+     * 0xFFFF is also a legal register value; prefer readRegisterResult()
+     * where an error must be told apart from register content.
+     * @param regAddr Register address to read
+     * @return Register value, or 0xFFFF on error
+     */
+    uint16_t readRegister(uint8_t regAddr) {
+        uint16_t value;
+        if (readRegister(regAddr, &value)) {
+            return value;
+        }
+        return 0xFFFF; // Error value
+    }
+    
+    /**
+     * Write a 16-bit register
+     * A cached copy of the register is marked dirty, so the next read fetches
+     * the value the device actually latched.
+     * @param regAddr Register address to write
+     * @param value 16-bit value to write
+     * @return true if write successful, false otherwise
+     */
+    bool writeRegister(uint8_t regAddr, uint16_t value) {
+        if (!_initialized) return false;
+        
+        return writeWords(regAddr, &value, 1);
+    }
+    
+    /**
+     * Write multiple consecutive 16-bit registers using burst transactions
+     * Register i is written at address startAddr + 2 * i. Bursts are split
+     * to fit BQ25723_I2C_BUFFER_SIZE.
+     * @param startAddr Starting register address
+     * @param values Values to write
+     * @param count Number of registers to write
+     * @return Number of registers successfully written
+     */
+    uint8_t writeMultipleRegisters(uint8_t startAddr, const uint16_t* values, uint8_t count) {
+        if (!_initialized || !values || count == 0) return 0;
+        
+        Guard guard(*this);
+        uint8_t successCount = 0;
+        for (uint8_t i = 0; i < count; i += BQ25723_BURST_MAX_WRITE_WORDS) {
+            uint8_t chunk = count - i;
+            if (chunk > BQ25723_BURST_MAX_WRITE_WORDS) chunk = BQ25723_BURST_MAX_WRITE_WORDS;
+            
+            if (writeWords(startAddr + 2 * i, &values[i], chunk)) {
+                successCount += chunk;
+            }
+        }
+        return successCount;
+    }
+    
+    /**
+     * Update selected bits of a register (read-modify-write)
+     * The current value comes from the shadow cache when available, and the
+     * write is skipped when the masked bits already hold the new value.
+     * @param regAddr Register address to update
+     * @param mask Bits to change
+     * @param value New value for the masked bits (already shifted into place)
+     * @return true if the register holds the requested bits, false otherwise
+     */
+    bool updateBits(uint8_t regAddr, uint16_t mask, uint16_t value) {
+        Guard guard(*this);
+        uint16_t current;
+        if (!readRegister(regAddr, &current)) {
+            return false;
+        }
+        
+        uint16_t updated = (current & ~mask) | (value & mask);
+        if (updated == current) {
+            return true;
+        }
+        
+        return writeRegister(regAddr, updated);
+    }
+    
+    /**
+     * Read a register through its descriptor
+     * @tparam Reg Register descriptor, e.g. BQ25723Regs::CHARGE_CURRENT
+     * @param value Pointer to store the read value
+     * @return true if read successful, false otherwise
+     */
+    template <typename Reg>
+    bool readRegister(uint16_t* value) {
+        return readRegister(Reg::address, value);
+    }
+    
+    /**
+     * Write a register through its descriptor
+     * Writing a read-only register fails to compile.
+     * @tparam Reg Register descriptor, e.g. BQ25723Regs::CHARGE_CURRENT
+     * @param value 16-bit value to write
+     * @return true if write successful, false otherwise
+     */
+    template <typename Reg>
+    bool writeRegister(uint16_t value) {
+        static_assert(!Reg::readOnly, "Register is read-only");
+        return writeRegister(Reg::address, value);
+    }
+    
+    /**
+     * Read a bit field
+     * @tparam Field Field descriptor, e.g. BQ25723Fields::WDTMR_ADJ
+     * @param code Pointer to store the field code (unshifted)
+     * @return true if read successful, false otherwise
+     */
+    template <typename Field>
+    bool readField(uint16_t* code) {
+        uint16_t word;
+        if (!code || !readRegister(Field::reg::address, &word)) {
+            return false;
+        }
+        *code = Field::get(word);
+        return true;
+    }
+    
+    /**
+     * Write a bit field, leaving the rest of the register unchanged
+     * Skips the bus write when the field already holds the code. Writing a
+     * field of a read-only register fails to compile.
+     * @tparam Field Field descriptor, e.g. BQ25723Fields::WDTMR_ADJ
+     * @param code Field code (unshifted, truncated to the field width)
+     * @return true if the field holds the code, false otherwise
+     */
+    template <typename Field>
+    bool writeField(uint16_t code) {
+        static_assert(!Field::reg::readOnly, "Field belongs to a read-only register");
+        return updateBits(Field::reg::address, Field::mask, Field::encode(code));
+    }
+    
+    /**
+     * Write a field given its physical value
+     * The value is rounded down to the field's resolution and clamped to
+     * its range.
+     * @tparam Field Field descriptor, e.g. BQ25723Fields::CHARGE_CURRENT
+     * @param value Value in the field's unit (mA or mV)
+     * @return true if the field holds the converted code, false otherwise
+     */
+    template <typename Field>
+    bool writeValue(uint16_t value) {
+        return writeField<Field>(Field::fromValue(value));
+    }
+    
+    /**
+     * Read a field as its physical value
+     * @tparam Field Field descriptor, e.g. BQ25723Fields::ADC_VBUS
+     * @param value Pointer to store the value in the field's unit (mA or mV)
+     * @return true if read successful, false otherwise
+     */
+    template <typename Field>
+    bool readValue(uint16_t* value) {
+        uint16_t word;
+        if (!value || !readRegister(Field::reg::address, &word)) {
+            return false;
+        }
+        *value = Field::decode(word);
+        return true;
+    }
+    
+    /**
+     * Set the charge current limit
+     * @param mA Value in mA, rounded down to the register resolution
+     * @return true if write successful, false otherwise
+     */
+    bool setChargeCurrent_mA(uint16_t mA) {
+        return writeValue<BQ25723Fields::CHARGE_CURRENT>(mA);
+    }
+    
+    /**
+     * Get the charge current limit
+     * @param mA Pointer to store the value in mA
+     * @return true if read successful, false otherwise
+     */
+    bool getChargeCurrent_mA(uint16_t* mA) {
+        return readValue<BQ25723Fields::CHARGE_CURRENT>(mA);
+    }
+    
+    /**
+     * Set the charge voltage limit
+     * @param mV Value in mV, rounded down to the register resolution
+     * @return true if write successful, false otherwise
+     */
+    bool setChargeVoltage_mV(uint16_t mV) {
+        return writeValue<BQ25723Fields::CHARGE_VOLTAGE>(mV);
+    }
+    
+    /**
+     * Get the charge voltage limit
+     * @param mV Pointer to store the value in mV
+     * @return true if read successful, false otherwise
+     */
+    bool getChargeVoltage_mV(uint16_t* mV) {
+        return readValue<BQ25723Fields::CHARGE_VOLTAGE>(mV);
+    }
+    
+    /**
+     * Set the OTG output voltage
+     * @param mV Value in mV, rounded down to the register resolution
+     * @return true if write successful, false otherwise
+     */
+    bool setOtgVoltage_mV(uint16_t mV) {
+        return writeValue<BQ25723Fields::OTG_VOLTAGE>(mV);
+    }
+    
+    /**
+     * Get the OTG output voltage
+     * @param mV Pointer to store the value in mV
+     * @return true if read successful, false otherwise
+     */
+    bool getOtgVoltage_mV(uint16_t* mV) {
+        return readValue<BQ25723Fields::OTG_VOLTAGE>(mV);
+    }
+    
+    /**
+     * Set the OTG output current limit
+     * @param mA Value in mA, rounded down to the register resolution
+     * @return true if write successful, false otherwise
+     */
+    bool setOtgCurrent_mA(uint16_t mA) {
+        return writeValue<BQ25723Fields::OTG_CURRENT>(mA);
+    }
+    
+    /**
+     * Get the OTG output current limit
+     * @param mA Pointer to store the value in mA
+     * @return true if read successful, false otherwise
+     */
+    bool getOtgCurrent_mA(uint16_t* mA) {
+        return readValue<BQ25723Fields::OTG_CURRENT>(mA);
+    }
+    
+    /**
+     * Set the input voltage limit (VINDPM)
+     * @param mV Value in mV, rounded down to the register resolution
+     * @return true if write successful, false otherwise
+     */
+    bool setInputVoltage_mV(uint16_t mV) {
+        return writeValue<BQ25723Fields::INPUT_VOLTAGE>(mV);
+    }
+    
+    /**
+     * Get the input voltage limit (VINDPM)
+     * @param mV Pointer to store the value in mV
+     * @return true if read successful, false otherwise
+     */
+    bool getInputVoltage_mV(uint16_t* mV) {
+        return readValue<BQ25723Fields::INPUT_VOLTAGE>(mV);
+    }
+    
+    /**
+     * Set the minimum system voltage
+     * @param mV Value in mV, rounded down to the register resolution
+     * @return true if write successful, false otherwise
+     */
+    bool setVsysMin_mV(uint16_t mV) {
+        return writeValue<BQ25723Fields::VSYS_MIN>(mV);
+    }
+    
+    /**
+     * Get the minimum system voltage
+     * @param mV Pointer to store the value in mV
+     * @return true if read successful, false otherwise
+     */
+    bool getVsysMin_mV(uint16_t* mV) {
+        return readValue<BQ25723Fields::VSYS_MIN>(mV);
+    }
+    
+    /**
+     * Set the host input current limit
+     * @param mA Value in mA, rounded down to the register resolution
+     * @return true if write successful, false otherwise
+     */
+    bool setInputCurrent_mA(uint16_t mA) {
+        return writeValue<BQ25723Fields::IIN_HOST>(mA);
+    }
+    
+    /**
+     * Get the host input current limit
+     * @param mA Pointer to store the value in mA
+     * @return true if read successful, false otherwise
+     */
+    bool getInputCurrent_mA(uint16_t* mA) {
+        return readValue<BQ25723Fields::IIN_HOST>(mA);
+    }
+    
+    /**
+     * Get the input current limit in effect (IIN_DPM)
+     * @param mA Pointer to store the value in mA
+     * @return true if read successful, false otherwise
+     */
+    bool getInputCurrentDpm_mA(uint16_t* mA) {
+        return readValue<BQ25723Fields::IIN_DPM>(mA);
+    }
+    
+    /**
+     * Get the last ADC result for VBUS
+     * @param mV Pointer to store the value in mV
+     * @return true if read successful, false otherwise
+     */
+    bool getVbus_mV(uint16_t* mV) {
+        return readValue<BQ25723Fields::ADC_VBUS>(mV);
+    }
+    
+    /**
+     * Get the last ADC result for PSYS pin voltage
+     * @param mV Pointer to store the value in mV
+     * @return true if read successful, false otherwise
+     */
+    bool getPsys_mV(uint16_t* mV) {
+        return readValue<BQ25723Fields::ADC_PSYS>(mV);
+    }
     
-    // Helper function to check if communication is working
-    bool checkCommunication() {
-        _wire->beginTransmission(_address);
-        return (_wire->endTransmission() == 0);
+    /**
+     * Get the last ADC result for battery charge current
+     * @param mA Pointer to store the value in mA
+     * @return true if read successful, false otherwise
+     */
+    bool getIchg_mA(uint16_t* mA) {
+        return readValue<BQ25723Fields::ADC_ICHG>(mA);
     }
     
-public:
     /**
-     * Constructor
-     * @param address I2C address (default 0x6B)
-     * @param wire TwoWire instance to use (default &Wire)
-     * @param i2cSpeed I2C clock speed in Hz (default 100000)
+     * Get the last ADC result for battery discharge current
+     * @param mA Pointer to store the value in mA
+     * @return true if read successful, false otherwise
      */
-    BQ25723(uint8_t address = BQ25723_I2C_ADDR_DEFAULT, 
-            TwoWire* wire = &Wire, 
-            uint32_t i2cSpeed = 100000) 
-        : _address(address), _wire(wire), _i2cSpeed(i2cSpeed), _initialized(false) {}
+    bool getIdchg_mA(uint16_t* mA) {
+        return readValue<BQ25723Fields::ADC_IDCHG>(mA);
+    }
     
     /**
-     * Initialize the BQ25723 communication
-     * @param sdaPin SDA pin (default -1 uses default pins)
-     * @param sclPin SCL pin (default -1 uses default pins)
-     * @return true if device is detected, false otherwise
+     * Get the last ADC result for input current
+     * @param mA Pointer to store the value in mA
+     * @return true if read successful, false otherwise
      */
-    bool begin(int sdaPin = -1, int sclPin = -1) {
-        if (sdaPin >= 0 && sclPin >= 0) {
-            _wire->begin(sdaPin, sclPin);
-        } else {
-            _wire->begin();
-        }
+    bool getIin_mA(uint16_t* mA) {
+        return readValue<BQ25723Fields::ADC_IIN>(mA);
+    }
+    
+    /**
+     * Get the last ADC result for CMPIN pin voltage
+     * @param mV Pointer to store the value in mV
+     * @return true if read successful, false otherwise
+     */
+    bool getCmpin_mV(uint16_t* mV) {
+        return readValue<BQ25723Fields::ADC_CMPIN>(mV);
+    }
+    
+    /**
+     * Get the last ADC result for system voltage
+     * @param mV Pointer to store the value in mV
+     * @return true if read successful, false otherwise
+     */
+    bool getVsys_mV(uint16_t* mV) {
+        return readValue<BQ25723Fields::ADC_VSYS>(mV);
+    }
+    
+    /**
+     * Get the last ADC result for battery voltage
+     * @param mV Pointer to store the value in mV
+     * @return true if read successful, false otherwise
+     */
+    bool getVbat_mV(uint16_t* mV) {
+        return readValue<BQ25723Fields::ADC_VBAT>(mV);
+    }
+    
+    /**
+     * Read multiple consecutive 16-bit registers using burst transactions
+     * Register i is read from address startAddr + 2 * i. The pointer is set
+     * once per burst; bursts are split to fit BQ25723_I2C_BUFFER_SIZE.
+     * Always reads the bus, and refreshes the shadow cache when enabled.
+     * @param startAddr Starting register address
+     * @param buffer Buffer to store values
+     * @param count Number of registers to read
+     * @param validMask Optional pointer receiving bit i set for each buffer[i]
+     *                  read (count at most 32); failed slots are then left
+     *                  untouched instead of being filled with 0xFFFF
+     * @return Number of registers successfully read
+     */
+    uint8_t readMultipleRegisters(uint8_t startAddr, uint16_t* buffer, uint8_t count,
+                                  uint32_t* validMask = nullptr) {
+        if (validMask) *validMask = 0;
+        if (!_initialized || !buffer || count == 0) return 0;
         
-        _wire->setClock(_i2cSpeed);
+        Guard guard(*this);
+        uint8_t successCount = 0;
+        for (uint8_t i = 0; i < count; i += BQ25723_BURST_MAX_WORDS) {
+            uint8_t chunk = count - i;
+            if (chunk > BQ25723_BURST_MAX_WORDS) chunk = BQ25723_BURST_MAX_WORDS;
+            
+            uint8_t status = readChunk(startAddr + 2 * i, &buffer[i], chunk, validMask != nullptr);
+            if (status == BQ25723_BUS_OK) {
+                successCount += chunk;
+                if (validMask) *validMask |= slotMask(i, chunk);
+            } else if (!validMask) {
+                for (uint8_t j = 0; j < chunk; j++) {
+                    buffer[i + j] = 0xFFFF; // Mark as error
+                }
+            }
+        }
+        return successCount;
+    }
+    
+    /**
+     * Re-read only the registers missing from a previous batch read
+     * Consecutive missing slots are fetched as one burst each; slots already
+     * valid are neither read nor modified.
+     * @param startAddr Starting register address of the batch
+     * @param buffer Buffer holding the batch
+     * @param count Number of registers in the batch (at most 32)
+     * @param validMask Validity mask from readMultipleRegisters(), updated
+     * @return Number of registers successfully read by this call
+     */
+    uint8_t rereadInvalidRegisters(uint8_t startAddr, uint16_t* buffer, uint8_t count,
+                                   uint32_t* validMask) {
+        if (!_initialized || !buffer || !validMask || count == 0 || count > 32) return 0;
         
-        // Check if device is present
-        if (!isConnected()) {
-            _initialized = false;
+        Guard guard(*this);
+        uint8_t successCount = 0;
+        for (uint8_t i = 0; i < count; ) {
+            if (*validMask & (1UL << i)) {
+                i++;
+                continue;
+            }
+            uint8_t length = 1;
+            while (i + length < count && length < BQ25723_BURST_MAX_WORDS &&
+                   !(*validMask & (1UL << (i + length)))) {
+                length++;
+            }
+            if (readChunk(startAddr + 2 * i, &buffer[i], length, true) == BQ25723_BUS_OK) {
+                successCount += length;
+                *validMask |= slotMask(i, length);
+            }
+            i += length;
+        }
+        return successCount;
+    }
+    
+    /**
+     * Configure the ADC
+     * In continuous mode conversions start immediately; in one-shot mode
+     * call startAdcConversion() for each conversion.
+     * @param mode One-shot or continuous conversion
+     * The 3.06 V full-scale range is always selected; the PSYS and CMPIN
+     * results are decoded with its 12 mV LSB.
+     * @param channels BQ25723_ADC_CH_* bits to convert
+     * @return true if write successful, false otherwise
+     */
+    bool configureAdc(BQ25723AdcMode mode, uint8_t channels = BQ25723_ADC_CH_ALL) {
+        uint16_t value = BQ25723Fields::ADC_CONV::encode(mode) |
+                         BQ25723Fields::ADC_START::encode(mode == BQ25723_ADC_CONTINUOUS) |
+                         BQ25723Fields::ADC_FULLSCALE::encode(1) |
+                         BQ25723Fields::EN_ADC::encode(channels);
+        return updateBits(BQ25723_REG_ADC_OPTION,
+                          BQ25723Fields::ADC_CONV::mask | BQ25723Fields::ADC_START::mask |
+                          BQ25723Fields::ADC_FULLSCALE::mask | BQ25723Fields::EN_ADC::mask,
+                          value);
+    }
+    
+    /**
+     * Start a one-shot ADC conversion of the configured channels
+     * @return true if write successful, false otherwise
+     */
+    bool startAdcConversion() {
+        return writeField<BQ25723Fields::ADC_START>(1);
+    }
+    
+    /**
+     * Check if a one-shot conversion has finished (ADC_START self-clears)
+     * @param done Pointer to store the result
+     * @return true if read successful, false otherwise
+     */
+    bool isAdcConversionDone(bool* done) {
+        uint16_t start;
+        if (!done || !readField<BQ25723Fields::ADC_START>(&start)) {
             return false;
         }
+        *done = (start == 0);
+        return true;
+    }
+    
+    /**
+     * Read all four ADC result registers in one burst
+     * Values of channels that are not enabled are not meaningful.
+     * @param reading Pointer to store the scaled results
+     * @return true if read successful, false otherwise
+     */
+    bool readAdc(BQ25723AdcReading* reading) {
+        uint16_t raw[BQ25723_ADC_REG_COUNT];
+        if (!reading) return false;
         
-        _initialized = true;
+        Guard guard(*this);
+        if (readMultipleRegisters(BQ25723_REG_ADCVBUS_PSYS, raw, BQ25723_ADC_REG_COUNT) != BQ25723_ADC_REG_COUNT) {
+            return false;
+        }
+        decodeAdc(raw, reading);
+#if BQ25723_THREAD_SAFE
+        _telemetry.adc = *reading;
+        _published.publish(_telemetry);
+#endif
         return true;
     }
     
     /**
-     * Check if device is connected and responding
-     * @return true if device ACKs, false otherwise
+     * Scale raw ADC result registers
+     * @param raw ADCVBUS_PSYS, ADCIBAT, ADCIINCMPIN, ADCVSYSVBAT words
+     * @param reading Pointer to store the scaled results
      */
-    bool isConnected() {
-        return checkCommunication();
+    static void decodeAdc(const uint16_t* raw, BQ25723AdcReading* reading) {
+        using namespace BQ25723Fields;
+        reading->vbus_mV  = ADC_VBUS::decode(raw[0]);
+        reading->psys_mV  = ADC_PSYS::decode(raw[0]);
+        reading->ichg_mA  = ADC_ICHG::decode(raw[1]);
+        reading->idchg_mA = ADC_IDCHG::decode(raw[1]);
+        reading->iin_mA   = ADC_IIN::decode(raw[2]);
+        reading->cmpin_mV = ADC_CMPIN::decode(raw[2]);
+        reading->vsys_mV  = ADC_VSYS::decode(raw[3]);
+        reading->vbat_mV  = ADC_VBAT::decode(raw[3]);
     }
     
     /**
-     * Read a 16-bit register
-     * @param regAddr Register address to read
-     * @param value Pointer to store the read value
+     * Read status, IIN_DPM and all ADC results in one burst
+     * @param telemetry Pointer to store the decoded values
      * @return true if read successful, false otherwise
      */
-    bool readRegister(uint8_t regAddr, uint16_t* value) {
-        if (!_initialized || !value) return false;
+    bool readTelemetry(BQ25723Telemetry* telemetry) {
+        uint16_t raw[BQ25723_TELEMETRY_REG_COUNT];
+        if (!telemetry) return false;
         
-        // Send register address
-        _wire->beginTransmission(_address);
-        _wire->write(regAddr);
-        if (_wire->endTransmission(false) != 0) {
+        Guard guard(*this);
+        if (readMultipleRegisters(BQ25723_REG_CHARGER_STATUS, raw, BQ25723_TELEMETRY_REG_COUNT) != BQ25723_TELEMETRY_REG_COUNT) {
             return false;
         }
+        decodeTelemetry(raw, telemetry);
+#if BQ25723_THREAD_SAFE
+        _telemetry = *telemetry;
+        _published.publish(_telemetry);
+#endif
+        return true;
+    }
+    
+#if BQ25723_THREAD_SAFE
+    /**
+     * Copy the telemetry published by the latest readTelemetry()/readAdc()
+     * Never blocks on the bus mutex, so it is safe to call from any core.
+     * @param telemetry Pointer to store the copy
+     * @return Publish sequence number (increases with every update), 0 if
+     *         nothing has been read yet
+     */
+    uint32_t getLatestTelemetry(BQ25723Telemetry* telemetry) const {
+        if (!telemetry) return 0;
+        return _published.read(telemetry);
+    }
+#endif
+    
+    /**
+     * Decode raw registers CHARGER_STATUS through ADCVSYSVBAT
+     * @param raw BQ25723_TELEMETRY_REG_COUNT register words
+     * @param telemetry Pointer to store the decoded values
+     */
+    static void decodeTelemetry(const uint16_t* raw, BQ25723Telemetry* telemetry) {
+        telemetry->chargerStatus = raw[0];
+        telemetry->prochotStatus = raw[1];
+        telemetry->iinDpm_mA = BQ25723Fields::IIN_DPM::decode(raw[2]);
+        decodeAdc(&raw[3], &telemetry->adc);
+    }
+    
+    /**
+     * Read every documented register in two bursts (0x00-0x0E, 0x20-0x3E)
+     * The reserved range 0x10-0x1E is skipped and left invalid.
+     * @param map Pointer to store the values and validity mask
+     * @return true if both bursts succeeded
+     */
+    bool readRegisterMap(BQ25723RegisterMap* map) {
+        if (!map) return false;
         
-        // Read 2 bytes
-        if (_wire->requestFrom(_address, (uint8_t)2) != 2) {
+        const uint8_t lowCount = (BQ25723_REG_IIN_HOST >> 1) + 1;
+        const uint8_t highStart = BQ25723_REG_CHARGER_STATUS >> 1;
+        const uint8_t highCount = BQ25723_REG_COUNT - highStart;
+        
+        uint32_t lowMask, highMask;
+        readMultipleRegisters(BQ25723_REG_CHARGE_OPTION_0, map->words, lowCount, &lowMask);
+        readMultipleRegisters(BQ25723_REG_CHARGER_STATUS, &map->words[highStart], highCount, &highMask);
+        map->validMask = lowMask | (highMask << highStart);
+        return map->validMask == (uint32_t)(((1UL << lowCount) - 1) | ~((1UL << highStart) - 1));
+    }
+    
+    /**
+     * Set the charge watchdog timeout and start the keep-alive service
+     * While the service runs, writes adjacent to CHARGE_CURRENT or
+     * CHARGE_VOLTAGE are extended to rewrite them once half the timeout has
+     * passed, and serviceWatchdog() writes CHARGE_CURRENT itself only when
+     * the deadline approaches. The rewritten value is the last one read or
+     * written through this driver.
+     * @param timeout Watchdog timeout, or BQ25723_WATCHDOG_DISABLED to turn
+     *                the device watchdog and the service off
+     * @return true if the timeout was set and the timer reset
+     */
+    bool enableWatchdog(BQ25723WatchdogTimeout timeout) {
+        Guard guard(*this);
+        if (!writeField<BQ25723Fields::WDTMR_ADJ>(timeout)) {
             return false;
         }
+        _watchdogPeriodMs = watchdogPeriodMs(timeout);
+        return !_watchdogPeriodMs || kickWatchdog();
+    }
+    
+    /**
+     * Reset the charge watchdog now with a dedicated CHARGE_CURRENT write
+     * Reads CHARGE_CURRENT first if its value is not yet known.
+     * @return true if the watchdog was reset
+     */
+    bool kickWatchdog() {
+        if (!_initialized) return false;
         
-        // BQ25723 sends LSB first, then MSB
-        uint8_t lsb = _wire->read();
-        uint8_t msb = _wire->read();
-        *value = (msb << 8) | lsb;
+        Guard guard(*this);
+        if (!_watchdogKnown && !readWords(BQ25723_REG_CHARGE_CURRENT, &_watchdogWords[0], 1)) {
+            return false;
+        }
         
-        return true;
+        // Copy first: the write refreshes _watchdogWords
+        uint8_t slot = (_watchdogKnown & 1) ? 0 : 1;
+        uint16_t value = _watchdogWords[slot];
+        return writeWords(slot ? BQ25723_REG_CHARGE_VOLTAGE : BQ25723_REG_CHARGE_CURRENT, &value, 1);
     }
     
     /**
-     * Read a 16-bit register (convenience overload)
-     * @param regAddr Register address to read
-     * @return Register value, or 0xFFFF on error
+     * Keep the charge watchdog alive; call regularly from the main loop
+     * Generates no bus traffic until BQ25723_WATCHDOG_DEADLINE_PCT of the
+     * timeout has passed without a resetting write.
+     * @return true unless a needed keep-alive write failed
      */
-    uint16_t readRegister(uint8_t regAddr) {
-        uint16_t value;
-        if (readRegister(regAddr, &value)) {
-            return value;
+    bool serviceWatchdog() {
+        Guard guard(*this);
+        if (!watchdogElapsed(BQ25723_WATCHDOG_DEADLINE_PCT)) {
+            return true;
         }
-        return 0xFFFF; // Error value
+        return kickWatchdog();
     }
     
     /**
-     * Write a 16-bit register
-     * @param regAddr Register address to write
-     * @param value 16-bit value to write
-     * @return true if write successful, false otherwise
+     * Get the time left before the device watchdog expires
+     * @return Milliseconds until expiry (0 if overdue), or 0xFFFFFFFF while
+     *         the service is off
      */
-    bool writeRegister(uint8_t regAddr, uint16_t value) {
+    uint32_t getWatchdogRemainingMs() const {
+        Guard guard(*this);
+        if (!_watchdogPeriodMs) return 0xFFFFFFFF;
+        uint32_t elapsed = millis() - _watchdogKickMs;
+        return (elapsed < _watchdogPeriodMs) ? _watchdogPeriodMs - elapsed : 0;
+    }
+    
+    /**
+     * Capture every writable configuration register in two burst reads
+     * @param config Pointer to store the values
+     * @return true if all registers were read (config->validMask is full)
+     */
+    bool saveConfig(BQ25723Config* config) {
+        if (!config) return false;
+        
+        const uint8_t half = BQ25723_CONFIG_REG_COUNT / 2;
+        uint32_t lowMask, highMask;
+        readMultipleRegisters(BQ25723_REG_CHARGE_OPTION_0, config->words, half, &lowMask);
+        readMultipleRegisters(BQ25723_REG_CHARGE_OPTION_1, &config->words[half], half, &highMask);
+        config->validMask = (uint16_t)(lowMask | (highMask << half));
+        return config->validMask == (1UL << BQ25723_CONFIG_REG_COUNT) - 1;
+    }
+    
+    /**
+     * Restore a configuration captured by saveConfig()
+     * The current values are read back in two bursts, and only registers
+     * that differ are written, as consecutive runs in address order. Slots
+     * missing from config->validMask are left alone; if a read-back fails,
+     * every valid slot in that half is written.
+     * @param config Configuration to apply
+     * @param written Optional pointer receiving the number of registers written
+     * @return true if the device now holds every valid slot of config
+     */
+    bool applyConfig(const BQ25723Config& config, uint8_t* written = nullptr) {
+        if (written) *written = 0;
         if (!_initialized) return false;
         
-        _wire->beginTransmission(_address);
-        _wire->write(regAddr);
-        _wire->write(value & 0xFF);        // LSB first
-        _wire->write((value >> 8) & 0xFF); // MSB second
+        Guard guard(*this);
+        BQ25723Config current;
+        saveConfig(&current);
+        return writeConfigChanges(config, current, written);
+    }
+    
+    /**
+     * Apply a profile defined with BQ25723_PROFILE()
+     * Each run of consecutive addresses goes out as one burst write; a run
+     * is read first only if one of its entries leaves bits untouched.
+     * @param profile Profile to apply
+     * @param written Optional pointer receiving the number of registers written
+     * @return true if every entry was written
+     */
+    bool applyProfile(const BQ25723Profile& profile, uint8_t* written = nullptr) {
+        if (written) *written = 0;
+        if (!_initialized) return false;
         
-        return (_wire->endTransmission(true) == 0);
+        Guard guard(*this);
+        uint16_t words[BQ25723_REG_COUNT];
+        uint16_t masks[BQ25723_REG_COUNT];
+        bool ok = true;
+        for (uint8_t i = 0; i < profile.count; ) {
+            const BQ25723ProfileEntry* entry = &profile.entries[i];
+            uint8_t start = pgm_read_byte(&entry->regAddr);
+            uint8_t length = 0;
+            bool partial = false;
+            while (i + length < profile.count && length < BQ25723_REG_COUNT &&
+                   pgm_read_byte(&entry[length].regAddr) == start + 2 * length) {
+                masks[length] = pgm_read_word(&entry[length].mask);
+                words[length] = pgm_read_word(&entry[length].bits);
+                partial |= (masks[length] != 0xFFFF);
+                length++;
+            }
+            i += length;
+            
+            if (partial) {
+                uint16_t current[BQ25723_REG_COUNT];
+                if (readMultipleRegisters(start, current, length) != length) {
+                    ok = false;
+                    continue;
+                }
+                for (uint8_t j = 0; j < length; j++) {
+                    words[j] = (current[j] & ~masks[j]) | words[j];
+                }
+            }
+            uint8_t count = writeMultipleRegisters(start, words, length);
+            if (written) *written += count;
+            ok &= (count == length);
+        }
+        return ok;
     }
     
     /**
-     * Read multiple consecutive registers
-     * @param startAddr Starting register address
-     * @param buffer Buffer to store values
-     * @param count Number of registers to read
-     * @return Number of registers successfully read
+     * Production start-up on a bus the application already initialized
+     * Probes the configured address and then the alternate one (0x6B/0x6A)
+     * instead of scanning, leaves the TwoWire peripheral initialized as it
+     * is apart from applying the driver's clock rate, and adds no delays.
+     * When a configuration is given, the live configuration registers are
+     * read back and only the words that differ are rewritten.
+     * @param config Expected configuration, or nullptr to only attach
+     * @param written Optional pointer receiving the number of registers written
+     * @return true if the device answered and holds config
      */
-    uint8_t readMultipleRegisters(uint8_t startAddr, uint16_t* buffer, uint8_t count) {
-        if (!_initialized || !buffer || count == 0) return 0;
+    bool beginFast(const BQ25723Config* config = nullptr, uint8_t* written = nullptr) {
+        if (written) *written = 0;
         
-        uint8_t successCount = 0;
-        for (uint8_t i = 0; i < count; i++) {
-            if (readRegister(startAddr + i, &buffer[i])) {
-                successCount++;
-            } else {
-                buffer[i] = 0xFFFF; // Mark as error
+        Guard guard(*this);
+        _transport->setClock(_i2cSpeed);
+        if (!attach()) {
+            uint8_t original = _address;
+            setAddress(original == BQ25723_I2C_ADDR_DEFAULT ? BQ25723_I2C_ADDR_ALT
+                                                            : BQ25723_I2C_ADDR_DEFAULT);
+            if (!attach()) {
+                setAddress(original);
+                return false;
             }
         }
-        return successCount;
+        if (!config) return true;
+        
+        BQ25723Config current;
+        saveConfig(&current);
+        current.validMask &= config->validMask;
+        return writeConfigChanges(*config, current, written);
+    }
+    
+    /**
+     * Format a register map as one text line per documented register
+     * MANUFACTURER_ID and DEVICE_ID are the low and high bytes of the 0x2E word.
+     * @param map Register values, e.g. from readRegisterMap()
+     * @param buffer Output buffer; always NUL-terminated when size > 0
+     * @param size Buffer size in bytes
+     * @return Number of characters written (whole lines only)
+     */
+    static size_t formatRegisterMap(const BQ25723RegisterMap& map, char* buffer, size_t size) {
+        if (!buffer || size == 0) return 0;
+        
+        size_t length = 0;
+        for (uint8_t i = 0; i < getRegisterCount(); i++) {
+            if (length + BQ25723_DUMP_LINE_MAX + 1 > size) break;
+            
+            length += formatRegisterLine(&buffer[length], map, getRegisterAddress(i));
+        }
+        buffer[length] = '\0';
+        return length;
+    }
+    
+    /**
+     * Read every register and format it into a caller buffer
+     * @param buffer Output buffer; always NUL-terminated when size > 0
+     * @param size Buffer size in bytes (about 32 bytes per register)
+     * @return Number of characters written
+     */
+    size_t dumpRegisters(char* buffer, size_t size) {
+        BQ25723RegisterMap map;
+        readRegisterMap(&map);
+        return formatRegisterMap(map, buffer, size);
+    }
+    
+    /**
+     * Read every register in bursts and print one line per register
+     * Lines are formatted into a BQ25723_DUMP_BUFFER_SIZE stack buffer and
+     * emitted with a single write when they fit.
+     * @param out Destination, e.g. Serial
+     * @return Number of bytes written
+     */
+    size_t dumpRegisters(Print& out) {
+        BQ25723RegisterMap map;
+        readRegisterMap(&map);
+        
+        char buffer[BQ25723_DUMP_BUFFER_SIZE];
+        size_t length = 0;
+        size_t written = 0;
+        for (uint8_t i = 0; i < getRegisterCount(); i++) {
+            if (length + BQ25723_DUMP_LINE_MAX > sizeof(buffer)) {
+                written += out.write((const uint8_t*)buffer, length);
+                length = 0;
+            }
+            
+            length += formatRegisterLine(&buffer[length], map, getRegisterAddress(i));
+        }
+        written += out.write((const uint8_t*)buffer, length);
+        return written;
     }
     
     /**
@@ -195,6 +2491,179 @@ public:
     void setAddress(uint8_t newAddress) {
         _address = newAddress;
         _initialized = false; // Force re-initialization
+        invalidateCache();
+    }
+    
+    /**
+     * Enable or disable the shadow register cache
+     * While enabled, reads of non-volatile registers are served from RAM
+     * once the register has been read from or written to the device.
+     * @param enable true to enable, false to disable and drop cached values
+     */
+    void enableCache(bool enable) {
+        Guard guard(*this);
+        _cacheEnabled = enable;
+        invalidateCache();
+    }
+    
+    /**
+     * Get shadow cache status
+     * @return true if the shadow cache is enabled
+     */
+    bool isCacheEnabled() const {
+        return _cacheEnabled;
+    }
+    
+    /**
+     * Mark every cached register dirty
+     */
+    void invalidateCache() {
+        Guard guard(*this);
+        _cacheValid = 0;
+    }
+    
+    /**
+     * Mark one cached register dirty so the next read goes to the bus
+     * @param regAddr Register address
+     */
+    void invalidateCache(uint8_t regAddr) {
+        Guard guard(*this);
+        if (regAddr < 2 * BQ25723_REG_COUNT) {
+            _cacheValid &= ~(1UL << (regAddr >> 1));
+        }
+    }
+    
+    /**
+     * Reload all cacheable registers from the device in burst transactions
+     * @return true if every register was read successfully
+     */
+    bool refreshCache() {
+        uint16_t values[8];
+        bool ok = true;
+        
+        invalidateCache();
+        ok &= (readMultipleRegisters(BQ25723_REG_CHARGE_OPTION_0, values, 8) == 8);
+        ok &= (readMultipleRegisters(BQ25723_REG_MANUFACTURER_ID, values, 1) == 1);
+        ok &= (readMultipleRegisters(BQ25723_REG_CHARGE_OPTION_1, values, 8) == 8);
+        return ok;
+    }
+    
+    /**
+     * Check if a register changes independently of host writes
+     * Volatile registers are never cached.
+     * @param regAddr Register address
+     * @return true for status, ADC and ADC control registers
+     */
+    static bool isVolatileRegister(uint8_t regAddr) {
+        return (getRegisterFlags(regAddr) & BQ25723_FLAG_VOLATILE) != 0;
+    }
+    
+    /**
+     * Get the flags of a register from the register map
+     * @param regAddr Register address
+     * @return BQ25723_FLAG_* bits, BQ25723_FLAG_UNKNOWN if not in the map
+     */
+    static uint8_t getRegisterFlags(uint8_t regAddr) {
+        switch(regAddr) {
+#define BQ25723_X_FLAGS(name, addr, flags) case addr: return flags;
+            BQ25723_REGISTER_MAP(BQ25723_X_FLAGS)
+#undef BQ25723_X_FLAGS
+            default:                             return BQ25723_FLAG_UNKNOWN;
+        }
+    }
+    
+    /**
+     * Get the number of registers in the register map
+     * @return Register count
+     */
+    static uint8_t getRegisterCount() {
+        return sizeof(registerAddresses());
+    }
+    
+    /**
+     * Get a register address by its position in the register map
+     * @param index Position, 0 to getRegisterCount() - 1
+     * @return Register address (in ascending order)
+     */
+    static uint8_t getRegisterAddress(uint8_t index) {
+        return pgm_read_byte(&registerAddresses()[index]);
+    }
+    
+#if BQ25723_ENABLE_STATS
+    /**
+     * Copy the bus transaction statistics
+     * @param stats Pointer to store the snapshot
+     */
+    void getStats(BQ25723BusStats* stats) const {
+        Guard guard(*this);
+        if (stats) *stats = _stats;
+    }
+    
+    /**
+     * Clear the bus transaction statistics
+     */
+    void resetStats() {
+        Guard guard(*this);
+        memset(&_stats, 0, sizeof(_stats));
+        _stats.minLatencyUs = UINT32_MAX;
+    }
+#endif
+
+#if BQ25723_ENABLE_TRACE
+    /**
+     * Write traced transactions to a stream as binary packets
+     * Packet: 0xB3, entry count (u8, at most 16), dropped total (u32 LE),
+     * then 12 bytes per entry: timestamp (u32 LE, us), latency (u16 LE,
+     * us), first word (u16 LE), register address, word count, flags,
+     * status. Decode with tools/bq25723_trace.py. Call from one task only;
+     * entries keep being recorded while packets are written.
+     * @param out Destination, e.g. Serial
+     * @param maxEntries Most entries to drain
+     * @return Number of entries written, 0 if none were pending
+     */
+    uint8_t drainTrace(Print& out, uint8_t maxEntries = 255) {
+        BQ25723TraceEntry entries[16];
+        uint8_t packet[6 + sizeof(entries) / sizeof(entries[0]) * BQ25723_TRACE_ENTRY_SIZE];
+        uint8_t total = 0;
+        
+        while (total < maxEntries) {
+            uint8_t want = maxEntries - total;
+            if (want > sizeof(entries) / sizeof(entries[0])) want = sizeof(entries) / sizeof(entries[0]);
+            uint8_t n = (uint8_t)_trace.drain(entries, want);
+            if (!n) break;
+            
+            uint32_t dropped = _trace.dropped();
+            uint8_t length = 0;
+            packet[length++] = BQ25723_TRACE_PACKET;
+            packet[length++] = n;
+            packet[length++] = dropped & 0xFF;
+            packet[length++] = (dropped >> 8) & 0xFF;
+            packet[length++] = (dropped >> 16) & 0xFF;
+            packet[length++] = (dropped >> 24) & 0xFF;
+            for (uint8_t i = 0; i < n; i++) {
+                length += putTraceEntry(&packet[length], entries[i]);
+            }
+            out.write(packet, length);
+            total += n;
+        }
+        return total;
+    }
+    
+    /**
+     * Get the number of traced transactions waiting to be drained
+     * @return Entry count
+     */
+    uint16_t getTracePending() const {
+        return _trace.size();
+    }
+#endif
+    
+    /**
+     * Get the status of the most recent bus transaction
+     * @return BQ25723BusStatus code (BQ25723_BUS_NOT_READY before the first)
+     */
+    uint8_t getLastStatus() const {
+        return _lastStatus;
     }
     
     /**
@@ -208,37 +2677,30 @@ public:
     /**
      * Get human-readable register name
      * @param regAddr Register address
-     * @return String with register name or "Unknown"
+     * @return String with register name or "UNKNOWN"
      */
     static const char* getRegisterName(uint8_t regAddr) {
-        switch(regAddr) {
-            case BQ25723_REG_CHARGE_OPTION_0:    return "CHARGE_OPTION_0";
-            case BQ25723_REG_CHARGE_CURRENT:     return "CHARGE_CURRENT";
-            case BQ25723_REG_CHARGE_VOLTAGE:     return "CHARGE_VOLTAGE";
-            case BQ25723_REG_OTG_VOLTAGE:        return "OTG_VOLTAGE";
-            case BQ25723_REG_OTG_CURRENT:        return "OTG_CURRENT";
-            case BQ25723_REG_INPUT_VOLTAGE:      return "INPUT_VOLTAGE";
-            case BQ25723_REG_VSYS_MIN:           return "VSYS_MIN";
-            case BQ25723_REG_IIN_HOST:           return "IIN_HOST";
-            case BQ25723_REG_CHARGER_STATUS:     return "CHARGER_STATUS";
-            case BQ25723_REG_PROCHOT_STATUS:     return "PROCHOT_STATUS";
-            case BQ25723_REG_IIN_DPM:            return "IIN_DPM";
-            case BQ25723_REG_ADCVBUS_PSYS:       return "ADCVBUS_PSYS";
-            case BQ25723_REG_ADCIBAT:            return "ADCIBAT";
-            case BQ25723_REG_ADCIINCMPIN:        return "ADCIINCMPIN";
-            case BQ25723_REG_ADCVSYSVBAT:        return "ADCVSYSVBAT";
-            case BQ25723_REG_MANUFACTURER_ID:    return "MANUFACTURER_ID";
-            case BQ25723_REG_DEVICE_ID:          return "DEVICE_ID";
-            case BQ25723_REG_CHARGE_OPTION_1:    return "CHARGE_OPTION_1";
-            case BQ25723_REG_CHARGE_OPTION_2:    return "CHARGE_OPTION_2";
-            case BQ25723_REG_CHARGE_OPTION_3:    return "CHARGE_OPTION_3";
-            case BQ25723_REG_PROCHOT_OPTION_0:   return "PROCHOT_OPTION_0";
-            case BQ25723_REG_PROCHOT_OPTION_1:   return "PROCHOT_OPTION_1";
-            case BQ25723_REG_ADC_OPTION:         return "ADC_OPTION";
-            case BQ25723_REG_CHARGE_OPTION_4:    return "CHARGE_OPTION_4";
-            case BQ25723_REG_VMIN_ACT_PROT:      return "VMIN_ACT_PROT";
-            default:                             return "UNKNOWN";
+        if (regAddr >= BQ25723_NAME_TABLE_SIZE) return "UNKNOWN";
+        return (const char*)pgm_read_ptr(&registerNames()[regAddr]);
+    }
+    
+    /**
+     * Look up a register address by name (case-insensitive, e.g. "charge_option_0")
+     * @param name Register name as returned by getRegisterName()
+     * @return Register address, or -1 if no register has that name
+     */
+    static int16_t findRegister(const char* name) {
+        if (!name) return -1;
+        
+        // Distinct case labels also prove at compile time that no two names collide
+        uint8_t regAddr;
+        switch (runtimeNameHash(name)) {
+#define BQ25723_X_HASH(name, addr, flags) case nameHash(#name): regAddr = addr; break;
+            BQ25723_REGISTER_MAP(BQ25723_X_HASH)
+#undef BQ25723_X_HASH
+            default: return -1;
         }
+        return namesEqual(name, getRegisterName(regAddr)) ? regAddr : -1;
     }
 };
 
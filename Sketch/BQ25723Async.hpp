@@ -0,0 +1,239 @@
+/**
+ * BQ25723Async.hpp
+ *
+ * Non-blocking register transactions for the BQ25723 on the ESP32
+ * A FreeRTOS worker task owns the bus and executes queued reads/writes while
+ * the submitting task keeps running.
+ */
+
+#ifndef BQ25723_ASYNC_HPP
+#define BQ25723_ASYNC_HPP
+
+#if defined(ESP32)
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include "BQ25723.hpp"
+
+// Lifecycle of a submitted operation
+enum BQ25723AsyncState : uint8_t {
+    BQ25723_ASYNC_IDLE = 0,
+    BQ25723_ASYNC_PENDING,
+    BQ25723_ASYNC_DONE,
+    BQ25723_ASYNC_FAILED
+};
+
+struct BQ25723AsyncOp;
+
+// Completion callback, invoked from the worker task before the final state
+// is published; op stays valid for the call, but op->state is still
+// PENDING, so the outcome is passed in ok
+typedef void (*BQ25723AsyncCallback)(BQ25723AsyncOp* op, bool ok, void* arg);
+
+/**
+ * A single register transaction
+ * Owned by the caller and must stay valid until it completes.
+ */
+struct BQ25723AsyncOp {
+    uint8_t regAddr;
+    bool write;
+    uint16_t value;        // Value to write, or value read on completion
+    BQ25723AsyncState state;
+    BQ25723AsyncCallback callback;
+    void* arg;
+    
+    BQ25723AsyncOp()
+        : regAddr(0), write(false), value(0), state(BQ25723_ASYNC_IDLE),
+          callback(nullptr), arg(nullptr) {}
+    
+    /**
+     * Get the current state (safe to poll from any task)
+     * @return Operation state
+     */
+    BQ25723AsyncState getState() const {
+        return (BQ25723AsyncState)__atomic_load_n((const uint8_t*)&state, __ATOMIC_ACQUIRE);
+    }
+    
+    /**
+     * Check if the operation has finished
+     * @return true once the transaction succeeded or failed
+     */
+    bool isDone() const {
+        BQ25723AsyncState s = getState();
+        return s == BQ25723_ASYNC_DONE || s == BQ25723_ASYNC_FAILED;
+    }
+    
+    /**
+     * Check if the operation finished successfully
+     * @return true if the transaction succeeded
+     */
+    bool succeeded() const {
+        return getState() == BQ25723_ASYNC_DONE;
+    }
+};
+
+class BQ25723Async {
+private:
+    BQ25723& _charger;
+    QueueHandle_t _queue;
+    TaskHandle_t _task;
+    bool _exited;          // Set by the worker as its last access to this object
+    
+    static void workerTask(void* param) {
+        BQ25723Async* self = static_cast<BQ25723Async*>(param);
+        BQ25723AsyncOp* op;
+        
+        for (;;) {
+            if (xQueueReceive(self->_queue, &op, portMAX_DELAY) != pdTRUE) {
+                continue;
+            }
+            if (!op) break;   // Stop request from end()
+            
+            bool ok;
+            if (op->write) {
+                ok = self->_charger.writeRegister(op->regAddr, op->value);
+            } else {
+                ok = self->_charger.readRegister(op->regAddr, &op->value);
+            }
+            
+            // Run the callback before publishing: the owner may reuse the
+            // op as soon as it observes the final state
+            if (op->callback) {
+                op->callback(op, ok, op->arg);
+            }
+            __atomic_store_n((uint8_t*)&op->state,
+                             (uint8_t)(ok ? BQ25723_ASYNC_DONE : BQ25723_ASYNC_FAILED),
+                             __ATOMIC_RELEASE);
+        }
+        
+        __atomic_store_n(&self->_exited, true, __ATOMIC_RELEASE);
+        vTaskDelete(nullptr);
+    }
+    
+    bool submit(BQ25723AsyncOp* op) {
+        if (!_queue || !op || op->getState() == BQ25723_ASYNC_PENDING) return false;
+        
+        op->state = BQ25723_ASYNC_PENDING;
+        if (xQueueSend(_queue, &op, 0) != pdTRUE) {
+            op->state = BQ25723_ASYNC_IDLE;
+            return false;
+        }
+        return true;
+    }
+    
+public:
+    /**
+     * Constructor
+     * @param charger Initialized driver; while the worker runs, all bus
+     *                access to this device should go through it
+     */
+    explicit BQ25723Async(BQ25723& charger)
+        : _charger(charger), _queue(nullptr), _task(nullptr), _exited(false) {}
+    
+    ~BQ25723Async() {
+        end();
+    }
+    
+    /**
+     * Start the worker task
+     * @param queueDepth Maximum number of outstanding operations
+     * @param priority FreeRTOS priority of the worker
+     * @param core Core to pin the worker to (default no affinity)
+     * @param stackSize Worker stack size in bytes
+     * @return true if the worker is running
+     */
+    bool begin(uint8_t queueDepth = 8, UBaseType_t priority = 5,
+               BaseType_t core = tskNO_AFFINITY, uint32_t stackSize = 3072) {
+        if (_task) return true;
+        
+        _queue = xQueueCreate(queueDepth, sizeof(BQ25723AsyncOp*));
+        if (!_queue) return false;
+        _exited = false;
+        
+        if (xTaskCreatePinnedToCore(workerTask, "bq25723", stackSize, this,
+                                    priority, &_task, core) != pdPASS) {
+            vQueueDelete(_queue);
+            _queue = nullptr;
+            _task = nullptr;
+            return false;
+        }
+        return true;
+    }
+    
+    /**
+     * Stop the worker task
+     * Waits for the transaction in progress to finish, so the bus and the
+     * driver's mutex are released. Operations still queued complete as
+     * FAILED without running their callbacks. Do not call from a callback.
+     */
+    void end() {
+        if (_task) {
+            BQ25723AsyncOp* stop = nullptr;
+            xQueueSendToFront(_queue, &stop, portMAX_DELAY);
+            while (!__atomic_load_n(&_exited, __ATOMIC_ACQUIRE)) {
+                vTaskDelay(1);
+            }
+            _task = nullptr;
+        }
+        if (_queue) {
+            BQ25723AsyncOp* op;
+            while (xQueueReceive(_queue, &op, 0) == pdTRUE) {
+                if (op) __atomic_store_n((uint8_t*)&op->state, (uint8_t)BQ25723_ASYNC_FAILED, __ATOMIC_RELEASE);
+            }
+            vQueueDelete(_queue);
+            _queue = nullptr;
+        }
+    }
+    
+    /**
+     * Queue a register read
+     * @param op Operation storage; op->value holds the result when done
+     * @param regAddr Register address to read
+     * @param callback Optional completion callback (runs on the worker task)
+     * @param arg Argument passed to the callback
+     * @return true if queued, false if the queue is full or op is busy
+     */
+    bool submitRead(BQ25723AsyncOp* op, uint8_t regAddr,
+                    BQ25723AsyncCallback callback = nullptr, void* arg = nullptr) {
+        if (!op) return false;
+        op->regAddr = regAddr;
+        op->write = false;
+        op->callback = callback;
+        op->arg = arg;
+        return submit(op);
+    }
+    
+    /**
+     * Queue a register write
+     * @param op Operation storage
+     * @param regAddr Register address to write
+     * @param value 16-bit value to write
+     * @param callback Optional completion callback (runs on the worker task)
+     * @param arg Argument passed to the callback
+     * @return true if queued, false if the queue is full or op is busy
+     */
+    bool submitWrite(BQ25723AsyncOp* op, uint8_t regAddr, uint16_t value,
+                     BQ25723AsyncCallback callback = nullptr, void* arg = nullptr) {
+        if (!op) return false;
+        op->regAddr = regAddr;
+        op->write = true;
+        op->value = value;
+        op->callback = callback;
+        op->arg = arg;
+        return submit(op);
+    }
+    
+    /**
+     * Get the number of operations waiting for the worker
+     * @return Queued operation count
+     */
+    uint8_t pending() const {
+        return _queue ? (uint8_t)uxQueueMessagesWaiting(_queue) : 0;
+    }
+};
+
+#endif // ESP32
+
+#endif // BQ25723_ASYNC_HPP
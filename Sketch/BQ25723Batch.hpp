@@ -0,0 +1,166 @@
+/**
+ * BQ25723Batch.hpp
+ *
+ * Transaction batching for the BQ25723
+ * Collects register reads/writes and flushes them on commit() as the fewest
+ * burst transactions: repeated writes to one register collapse to the last
+ * value, and neighbouring registers share one auto-increment transfer.
+ */
+
+#ifndef BQ25723_BATCH_HPP
+#define BQ25723_BATCH_HPP
+
+#include <Arduino.h>
+#include "BQ25723.hpp"
+
+class BQ25723Batch {
+private:
+    BQ25723& _charger;
+    uint32_t _writeMask;
+    uint32_t _readMask;
+    uint16_t _writeValues[BQ25723_REG_COUNT];
+    uint16_t* _readTargets[BQ25723_REG_COUNT];
+    uint8_t _transactions;
+    
+    static bool validRegister(uint8_t regAddr) {
+        return !(regAddr & 1) && regAddr < 2 * BQ25723_REG_COUNT;
+    }
+    
+    static bool readableRegister(uint8_t regAddr) {
+        return validRegister(regAddr) && !(BQ25723::getRegisterFlags(regAddr) & BQ25723_FLAG_UNKNOWN);
+    }
+    
+    static bool writableRegister(uint8_t regAddr) {
+        return validRegister(regAddr) &&
+               !(BQ25723::getRegisterFlags(regAddr) & (BQ25723_FLAG_UNKNOWN | BQ25723_FLAG_READ_ONLY));
+    }
+    
+    // Find the next run of set bits at or after slot, allowing runs to
+    // bridge up to maxGap clear bits; returns false when no bits remain
+    static bool nextRun(uint32_t mask, uint8_t& slot, uint8_t& length, uint8_t maxGap) {
+        while (slot < BQ25723_REG_COUNT && !(mask & (1UL << slot))) slot++;
+        if (slot >= BQ25723_REG_COUNT) return false;
+        
+        uint8_t end = slot;
+        uint8_t gap = 0;
+        for (uint8_t i = slot + 1; i < BQ25723_REG_COUNT; i++) {
+            if (mask & (1UL << i)) {
+                end = i;
+                gap = 0;
+            } else if (++gap > maxGap) {
+                break;
+            }
+        }
+        length = end - slot + 1;
+        return true;
+    }
+    
+public:
+    /**
+     * Constructor
+     * @param charger Driver the batch is flushed to
+     */
+    explicit BQ25723Batch(BQ25723& charger)
+        : _charger(charger), _writeMask(0), _readMask(0), _transactions(0) {}
+    
+    /**
+     * Queue a register write; a later write to the same register replaces it
+     * @param regAddr Register address (even, 0x00-0x3E)
+     * @param value 16-bit value to write
+     * @return true if queued, false for an unknown or read-only register
+     */
+    bool write(uint8_t regAddr, uint16_t value) {
+        if (!writableRegister(regAddr)) return false;
+        _writeValues[regAddr >> 1] = value;
+        _writeMask |= (1UL << (regAddr >> 1));
+        return true;
+    }
+    
+    /**
+     * Queue a register read; performed after all queued writes
+     * @param regAddr Register address (even, 0x00-0x3E)
+     * @param value Where to store the value on commit()
+     * @return true if queued, false for an unknown register or invalid pointer
+     */
+    bool read(uint8_t regAddr, uint16_t* value) {
+        if (!readableRegister(regAddr) || !value) return false;
+        _readTargets[regAddr >> 1] = value;
+        _readMask |= (1UL << (regAddr >> 1));
+        return true;
+    }
+    
+    /**
+     * Check if a write to a register is queued
+     * @param regAddr Register address
+     * @param value Optional pointer receiving the queued value
+     * @return true if a write is pending
+     */
+    bool hasPendingWrite(uint8_t regAddr, uint16_t* value = nullptr) const {
+        if (!validRegister(regAddr) || !(_writeMask & (1UL << (regAddr >> 1)))) return false;
+        if (value) *value = _writeValues[regAddr >> 1];
+        return true;
+    }
+    
+    /**
+     * Check if anything is queued
+     * @return true if no reads or writes are pending
+     */
+    bool isEmpty() const {
+        return _writeMask == 0 && _readMask == 0;
+    }
+    
+    /**
+     * Drop all queued operations
+     */
+    void clear() {
+        _writeMask = 0;
+        _readMask = 0;
+    }
+    
+    /**
+     * Flush queued writes (in address order) then queued reads
+     * Reads bridge single unrequested registers when that saves a transaction.
+     * The batch is emptied whether or not every transaction succeeds.
+     * @return true if every queued operation succeeded
+     */
+    bool commit() {
+        bool ok = true;
+        uint8_t slot, length;
+        _transactions = 0;
+        
+        // Writes must not touch registers that were not queued
+        slot = 0;
+        while (nextRun(_writeMask, slot, length, 0)) {
+            ok &= (_charger.writeMultipleRegisters(slot << 1, &_writeValues[slot], length) == length);
+            _transactions += (length + BQ25723_BURST_MAX_WRITE_WORDS - 1) / BQ25723_BURST_MAX_WRITE_WORDS;
+            slot += length;
+        }
+        
+        uint16_t values[BQ25723_REG_COUNT];
+        slot = 0;
+        while (nextRun(_readMask, slot, length, 1)) {
+            bool runOk = (_charger.readMultipleRegisters(slot << 1, &values[slot], length) == length);
+            _transactions += (length + BQ25723_BURST_MAX_WORDS - 1) / BQ25723_BURST_MAX_WORDS;
+            for (uint8_t i = slot; i < slot + length; i++) {
+                if (runOk && (_readMask & (1UL << i))) {
+                    *_readTargets[i] = values[i];
+                }
+            }
+            ok &= runOk;
+            slot += length;
+        }
+        
+        clear();
+        return ok;
+    }
+    
+    /**
+     * Get the number of bus transactions issued by the last commit()
+     * @return Transaction count
+     */
+    uint8_t lastTransactionCount() const {
+        return _transactions;
+    }
+};
+
+#endif // BQ25723_BATCH_HPP
@@ -0,0 +1,367 @@
+/**
+ * BQ25723Bench.hpp
+ *
+ * Bus-efficiency benchmark for the BQ25723 driver
+ * Runs driver scenarios against simulated BQ25723 devices on a bus model
+ * that charges every transaction its I2C bit and START/STOP timing at the
+ * selected clock rate. Results are printed as CSV, one line per scenario
+ * and clock rate, so runs can be compared release to release:
+ *
+ *   scenario,clock_khz,iterations,transactions,bytes,bus_us,tx_per_s,wall_us
+ *
+ * bus_us is the simulated time on the wire, tx_per_s the transaction rate
+ * that bus time allows, and wall_us the measured time spent in the driver
+ * (on the host, CPU time only; on a target, the driver's own overhead).
+ *
+ * Runs on a target from a sketch (BQ25723Bench::runAll(Serial)) and on the
+ * host through bench/bench_host.cpp.
+ */
+
+#ifndef BQ25723_BENCH_HPP
+#define BQ25723_BENCH_HPP
+
+#include <Arduino.h>
+#include "BQ25723.hpp"
+#include "BQ25723Bus.hpp"
+#include "BQ25723TransportMock.hpp"
+
+// Simulated devices on one bus
+#ifndef BQ25723_SIM_MAX_DEVICES
+#define BQ25723_SIM_MAX_DEVICES 4
+#endif
+
+static_assert(BQ25723_SIM_MAX_DEVICES >= 4, "Multi-device scenario needs four simulated devices");
+
+// Iterations per scenario used by runAll()
+#ifndef BQ25723_BENCH_ITERATIONS
+#define BQ25723_BENCH_ITERATIONS 100
+#endif
+
+/**
+ * Timed I2C bus model
+ * Routes transactions to mock devices by address and accumulates the time
+ * each one occupies the bus: 9 SCL periods per byte (8 data bits and ACK),
+ * plus bus-free, START, repeated-START and STOP timing from the I2C
+ * specification minimums for the clock's speed mode.
+ */
+class BQ25723SimBus : public BQ25723Transport {
+private:
+    BQ25723MockTransport* _devices[BQ25723_SIM_MAX_DEVICES];
+    uint8_t _deviceCount;
+    uint32_t _clockHz;
+    uint32_t _transactions;
+    uint32_t _bytes;
+    uint64_t _busTimeNs;
+    
+    BQ25723MockTransport* find(uint8_t address) {
+        for (uint8_t i = 0; i < _deviceCount; i++) {
+            if (_devices[i]->address() == address) return _devices[i];
+        }
+        return nullptr;
+    }
+    
+    // Charge one transaction of bytes on the wire (address bytes included)
+    void account(uint8_t bytes, bool repeatedStart) {
+        // tBUF, tHD;STA, tSU;STA, tSU;STO in ns for Sm, Fm and Fm+
+        uint32_t tBuf, tHdSta, tSuSta, tSuSto;
+        if (_clockHz >= BQ25723_I2C_SPEED_FAST_PLUS) {
+            tBuf = 500;  tHdSta = 260;  tSuSta = 260;  tSuSto = 260;
+        } else if (_clockHz >= BQ25723_I2C_SPEED_FAST) {
+            tBuf = 1300; tHdSta = 600;  tSuSta = 600;  tSuSto = 600;
+        } else {
+            tBuf = 4700; tHdSta = 4000; tSuSta = 4700; tSuSto = 4000;
+        }
+        
+        uint64_t ns = tBuf + tHdSta + (uint64_t)bytes * 9 * (1000000000UL / _clockHz) + tSuSto;
+        if (repeatedStart) ns += tSuSta + tHdSta;
+        
+        _transactions++;
+        _bytes += bytes;
+        _busTimeNs += ns;
+    }
+    
+public:
+    BQ25723SimBus()
+        : _deviceCount(0), _clockHz(BQ25723_I2C_SPEED_STANDARD) {
+        resetCounters();
+    }
+    
+    /**
+     * Place a simulated device on the bus
+     * @param device Mock device; answers on device.address()
+     * @return true if added
+     */
+    bool addDevice(BQ25723MockTransport& device) {
+        if (_deviceCount >= BQ25723_SIM_MAX_DEVICES) return false;
+        _devices[_deviceCount++] = &device;
+        return true;
+    }
+    
+    bool begin(int, int) override {
+        return true;
+    }
+    
+    void setClock(uint32_t hz) override {
+        if (hz) _clockHz = hz;
+    }
+    
+    uint8_t probe(uint8_t address) override {
+        BQ25723MockTransport* device = find(address);
+        account(1, false);
+        return device ? device->probe(address) : (uint8_t)BQ25723_BUS_NACK_ADDRESS;
+    }
+    
+    uint8_t read(uint8_t address, uint8_t regAddr, uint8_t* data, uint8_t length) override {
+        BQ25723MockTransport* device = find(address);
+        uint8_t status = device ? device->read(address, regAddr, data, length) : (uint8_t)BQ25723_BUS_NACK_ADDRESS;
+        if (status == BQ25723_BUS_NACK_ADDRESS) {
+            account(1, false);
+        } else {
+            account(3 + length, true);   // Address, pointer, address, data
+        }
+        return status;
+    }
+    
+    uint8_t write(uint8_t address, uint8_t regAddr, const uint8_t* data, uint8_t length) override {
+        BQ25723MockTransport* device = find(address);
+        uint8_t status = device ? device->write(address, regAddr, data, length) : (uint8_t)BQ25723_BUS_NACK_ADDRESS;
+        account(status == BQ25723_BUS_NACK_ADDRESS ? 1 : 2 + length, false);
+        return status;
+    }
+    
+    /**
+     * Reset the transaction, byte and bus-time counters
+     */
+    void resetCounters() {
+        _transactions = 0;
+        _bytes = 0;
+        _busTimeNs = 0;
+    }
+    
+    /**
+     * Get the number of transactions since resetCounters()
+     * @return Transaction count
+     */
+    uint32_t transactions() const {
+        return _transactions;
+    }
+    
+    /**
+     * Get the bytes on the wire since resetCounters(), address bytes included
+     * @return Byte count
+     */
+    uint32_t bytes() const {
+        return _bytes;
+    }
+    
+    /**
+     * Get the simulated bus time since resetCounters()
+     * @return Bus time in microseconds
+     */
+    uint32_t busTimeUs() const {
+        return (uint32_t)(_busTimeNs / 1000);
+    }
+};
+
+// Outcome of one scenario at one clock rate
+struct BQ25723BenchResult {
+    const char* scenario;
+    uint32_t clockHz;
+    uint32_t iterations;
+    uint32_t transactions;
+    uint32_t bytes;
+    uint32_t busTimeUs;
+    uint32_t wallTimeUs;
+    
+    /**
+     * Get the transaction rate the simulated bus time allows
+     * @return Transactions per second (0 if no bus time was used)
+     */
+    uint32_t transactionsPerSecond() const {
+        return busTimeUs ? (uint32_t)((uint64_t)transactions * 1000000UL / busTimeUs) : 0;
+    }
+};
+
+class BQ25723Bench {
+private:
+    // Print sink that discards dump output
+    class NullPrint : public Print {
+    public:
+        size_t write(uint8_t) override {
+            return 1;
+        }
+        size_t write(const uint8_t*, size_t size) override {
+            return size;
+        }
+    };
+    
+    BQ25723SimBus _bus;
+    BQ25723MockTransport _devices[BQ25723_SIM_MAX_DEVICES];
+    uint32_t _clockHz;
+    uint32_t _startUs;
+    
+    void start() {
+        _bus.resetCounters();
+        _startUs = micros();
+    }
+    
+    BQ25723BenchResult finish(const char* scenario, uint32_t iterations) {
+        BQ25723BenchResult result;
+        result.wallTimeUs = micros() - _startUs;
+        result.scenario = scenario;
+        result.clockHz = _clockHz;
+        result.iterations = iterations;
+        result.transactions = _bus.transactions();
+        result.bytes = _bus.bytes();
+        result.busTimeUs = _bus.busTimeUs();
+        return result;
+    }
+    
+    static void printResult(Print& out, const BQ25723BenchResult& result) {
+        out.print(result.scenario);
+        out.print(',');
+        out.print(result.clockHz / 1000);
+        out.print(',');
+        out.print(result.iterations);
+        out.print(',');
+        out.print(result.transactions);
+        out.print(',');
+        out.print(result.bytes);
+        out.print(',');
+        out.print(result.busTimeUs);
+        out.print(',');
+        out.print(result.transactionsPerSecond());
+        out.print(',');
+        out.println(result.wallTimeUs);
+    }
+    
+public:
+    BQ25723Bench() : _clockHz(BQ25723_I2C_SPEED_STANDARD), _startUs(0) {
+        // Consecutive addresses below the default; the model needs no mux
+        for (uint8_t i = 0; i < BQ25723_SIM_MAX_DEVICES; i++) {
+            _devices[i].setAddress(BQ25723_I2C_ADDR_DEFAULT - i);
+            _bus.addDevice(_devices[i]);
+        }
+    }
+    
+    /**
+     * Select the simulated clock rate for the following scenarios
+     * @param hz Clock rate in Hz
+     */
+    void setClock(uint32_t hz) {
+        _clockHz = hz;
+    }
+    
+    /**
+     * Read and format every register (dumpRegisters())
+     * @param iterations Number of dumps
+     * @return Scenario result
+     */
+    BQ25723BenchResult fullDump(uint32_t iterations) {
+        BQ25723 charger(_bus, _devices[0].address(), _clockHz);
+        charger.begin();
+        NullPrint sink;
+        
+        start();
+        for (uint32_t i = 0; i < iterations; i++) {
+            charger.dumpRegisters(sink);
+        }
+        return finish("full_dump", iterations);
+    }
+    
+    /**
+     * Read all ADC results (readAdc())
+     * @param iterations Number of snapshots
+     * @return Scenario result
+     */
+    BQ25723BenchResult adcSnapshot(uint32_t iterations) {
+        BQ25723 charger(_bus, _devices[0].address(), _clockHz);
+        charger.begin();
+        BQ25723AdcReading reading;
+        
+        start();
+        for (uint32_t i = 0; i < iterations; i++) {
+            charger.readAdc(&reading);
+        }
+        return finish("adc_snapshot", iterations);
+    }
+    
+    /**
+     * Restore a saved configuration after three registers drifted
+     * (applyConfig())
+     * @param iterations Number of restores
+     * @return Scenario result
+     */
+    BQ25723BenchResult configApply(uint32_t iterations) {
+        BQ25723 charger(_bus, _devices[0].address(), _clockHz);
+        charger.begin();
+        BQ25723MockTransport& device = _devices[0];
+        device.poke(BQ25723_REG_CHARGE_CURRENT, 0x0200);
+        device.poke(BQ25723_REG_CHARGE_VOLTAGE, 0x41A0);
+        device.poke(BQ25723_REG_CHARGE_OPTION_1, 0x3300);
+        BQ25723Config config;
+        charger.saveConfig(&config);
+        
+        start();
+        for (uint32_t i = 0; i < iterations; i++) {
+            device.poke(BQ25723_REG_CHARGE_CURRENT, 0);
+            device.poke(BQ25723_REG_CHARGE_VOLTAGE, 0);
+            device.poke(BQ25723_REG_CHARGE_OPTION_1, 0);
+            charger.applyConfig(config);
+        }
+        return finish("config_apply", iterations);
+    }
+    
+    /**
+     * Poll status and ADC telemetry from every simulated device through a
+     * bus manager (BQ25723Bus::pollAll())
+     * The devices sit on distinct addresses, so the manager runs without a
+     * mux; the bus model stands in for its TwoWire peripheral.
+     * @param iterations Number of polling rounds
+     * @return Scenario result
+     */
+    BQ25723BenchResult multiDevicePoll(uint32_t iterations) {
+        BQ25723 c0(_bus, _devices[0].address(), _clockHz);
+        BQ25723 c1(_bus, _devices[1].address(), _clockHz);
+        BQ25723 c2(_bus, _devices[2].address(), _clockHz);
+        BQ25723 c3(_bus, _devices[3].address(), _clockHz);
+        BQ25723* chargers[] = { &c0, &c1, &c2, &c3 };
+        const uint8_t count = sizeof(chargers) / sizeof(chargers[0]);
+        
+        BQ25723Bus manager(&Wire, _clockHz);
+        manager.begin();
+        _bus.setClock(_clockHz);
+        for (uint8_t d = 0; d < count; d++) {
+            manager.addDevice(*chargers[d]);
+        }
+        BQ25723Telemetry telemetry[count];
+        
+        start();
+        for (uint32_t i = 0; i < iterations; i++) {
+            manager.pollAll(telemetry);
+        }
+        return finish("multi_device_poll", iterations);
+    }
+    
+    /**
+     * Run every scenario at 100 kHz, 400 kHz and 1 MHz and print CSV
+     * @param out Destination for the results
+     * @param iterations Iterations per scenario
+     */
+    void runAll(Print& out, uint32_t iterations = BQ25723_BENCH_ITERATIONS) {
+        static const uint32_t clocks[] = {
+            BQ25723_I2C_SPEED_STANDARD, BQ25723_I2C_SPEED_FAST, BQ25723_I2C_SPEED_FAST_PLUS
+        };
+        
+        out.println("scenario,clock_khz,iterations,transactions,bytes,bus_us,tx_per_s,wall_us");
+        for (uint8_t i = 0; i < sizeof(clocks) / sizeof(clocks[0]); i++) {
+            setClock(clocks[i]);
+            printResult(out, fullDump(iterations));
+            printResult(out, adcSnapshot(iterations));
+            printResult(out, configApply(iterations));
+            printResult(out, multiDevicePoll(iterations));
+        }
+    }
+};
+
+#endif // BQ25723_BENCH_HPP
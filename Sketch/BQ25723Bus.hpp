@@ -0,0 +1,310 @@
+/**
+ * BQ25723Bus.hpp
+ *
+ * Bus manager for several BQ25723 chargers
+ * Owns one TwoWire instance (initialized once), selects TCA9548-style mux
+ * channels only when they change, and polls status/ADC telemetry from each
+ * device with one burst read. recover() clears a stuck bus for all devices.
+ *
+ * With BQ25723_THREAD_SAFE a recursive bus lock is held from each mux
+ * select through the charger transaction, so tasks polling different
+ * devices cannot switch the mux under each other. Direct register access
+ * goes through access(), which holds the lock for the scope of its result.
+ */
+
+#ifndef BQ25723_BUS_HPP
+#define BQ25723_BUS_HPP
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "BQ25723.hpp"
+
+// Maximum number of chargers on one bus manager
+#ifndef BQ25723_BUS_MAX_DEVICES
+#define BQ25723_BUS_MAX_DEVICES 8
+#endif
+
+// Device connected directly to the bus, or bus without a mux
+#define BQ25723_MUX_NONE 0xFF
+
+// Default I2C address of a TCA9548A mux
+#define BQ25723_MUX_ADDR_DEFAULT 0x70
+
+class BQ25723Bus {
+private:
+    TwoWire* _wire;
+    uint32_t _i2cSpeed;
+    uint8_t _muxAddress;
+    uint8_t _muxChannel;   // Currently selected channel, BQ25723_MUX_NONE if unknown
+    int _sdaPin;           // Pins from begin(), -1 for the board defaults
+    int _sclPin;
+    bool _initialized;
+    
+    BQ25723* _devices[BQ25723_BUS_MAX_DEVICES];
+    uint8_t _channels[BQ25723_BUS_MAX_DEVICES];
+    uint8_t _order[BQ25723_BUS_MAX_DEVICES];   // Device indices sorted by mux channel
+    uint8_t _deviceCount;
+    uint8_t _next;         // Round-robin cursor for pollNext()
+    
+#if BQ25723_THREAD_SAFE
+    // Recursive so access() can be used while a poll holds the lock
+    StaticSemaphore_t _mutexBuffer;
+    SemaphoreHandle_t _mutex;
+#endif
+    
+    void lock() {
+#if BQ25723_THREAD_SAFE
+        xSemaphoreTakeRecursive(_mutex, portMAX_DELAY);
+#endif
+    }
+    
+    void unlock() {
+#if BQ25723_THREAD_SAFE
+        xSemaphoreGiveRecursive(_mutex);
+#endif
+    }
+    
+    // Holds the bus lock for its scope
+    class Lock {
+    public:
+        explicit Lock(BQ25723Bus& bus) : _bus(bus) {
+            _bus.lock();
+        }
+        ~Lock() {
+            _bus.unlock();
+        }
+    private:
+        BQ25723Bus& _bus;
+    };
+    
+    bool selectChannel(uint8_t channel) {
+        if (_muxAddress == BQ25723_MUX_NONE || channel == BQ25723_MUX_NONE) return true;
+        if (channel == _muxChannel) return true;
+        
+        _wire->beginTransmission(_muxAddress);
+        _wire->write((uint8_t)(1 << channel));
+        if (_wire->endTransmission(true) != 0) {
+            _muxChannel = BQ25723_MUX_NONE;
+            return false;
+        }
+        _muxChannel = channel;
+        return true;
+    }
+    
+public:
+    /**
+     * Scoped access to one charger, returned by access()
+     * Holds the bus lock and keeps the charger's mux channel selected until
+     * destroyed; other devices on the bus wait meanwhile, so keep it short.
+     */
+    class Access {
+    public:
+        Access(Access&& other) : _bus(other._bus), _charger(other._charger) {
+            other._bus = nullptr;
+            other._charger = nullptr;
+        }
+        
+        ~Access() {
+            if (_bus) _bus->unlock();
+        }
+        
+        /**
+         * Check if the charger is selected
+         * @return true if the charger can be used
+         */
+        explicit operator bool() const {
+            return _charger != nullptr;
+        }
+        
+        BQ25723* operator->() const {
+            return _charger;
+        }
+        
+        BQ25723& operator*() const {
+            return *_charger;
+        }
+        
+    private:
+        friend class BQ25723Bus;
+        
+        BQ25723Bus* _bus;      // Lock owner, nullptr once moved from
+        BQ25723* _charger;     // nullptr if the select failed
+        
+        Access(BQ25723Bus* bus, BQ25723* charger) : _bus(bus), _charger(charger) {}
+        Access(const Access&) = delete;
+        Access& operator=(const Access&) = delete;
+    };
+    
+    /**
+     * Constructor
+     * @param wire TwoWire instance owned by this manager (default &Wire)
+     * @param i2cSpeed I2C clock speed in Hz (default 100000)
+     * @param muxAddress I2C address of a TCA9548-style mux, or BQ25723_MUX_NONE
+     */
+    BQ25723Bus(TwoWire* wire = &Wire, uint32_t i2cSpeed = 100000,
+               uint8_t muxAddress = BQ25723_MUX_NONE)
+        : _wire(wire), _i2cSpeed(i2cSpeed), _muxAddress(muxAddress),
+          _muxChannel(BQ25723_MUX_NONE), _sdaPin(-1), _sclPin(-1), _initialized(false),
+          _deviceCount(0), _next(0) {
+#if BQ25723_THREAD_SAFE
+        _mutex = xSemaphoreCreateRecursiveMutexStatic(&_mutexBuffer);
+#endif
+    }
+    
+    /**
+     * Initialize the bus peripheral once for all devices
+     * @param sdaPin SDA pin (default -1 uses default pins)
+     * @param sclPin SCL pin (default -1 uses default pins)
+     * @return true if the bus is ready
+     */
+    bool begin(int sdaPin = -1, int sclPin = -1) {
+        Lock guard(*this);
+        if (!_initialized) {
+            _sdaPin = sdaPin;
+            _sclPin = sclPin;
+            if (sdaPin >= 0 && sclPin >= 0) {
+                _wire->begin(sdaPin, sclPin);
+            } else {
+                _wire->begin();
+            }
+            _wire->setClock(_i2cSpeed);
+            _initialized = true;
+        }
+        _muxChannel = BQ25723_MUX_NONE;
+        return true;
+    }
+    
+    /**
+     * Register a charger on this bus and attach to it
+     * The charger must be constructed with this manager's TwoWire instance;
+     * its begin() must not be called. Its auto-recovery is turned off: a
+     * charger's recover() would reset the shared peripheral without the mux
+     * state or clock the other devices rely on, so use recover() here.
+     * @param charger Charger to add
+     * @param muxChannel Mux channel the charger sits behind (0-7), or BQ25723_MUX_NONE
+     * @return Device index, or -1 if full or the device did not respond
+     */
+    int8_t addDevice(BQ25723& charger, uint8_t muxChannel = BQ25723_MUX_NONE) {
+        Lock guard(*this);
+        if (!_initialized || _deviceCount >= BQ25723_BUS_MAX_DEVICES) return -1;
+        charger.setAutoRecover(false);
+        if (!selectChannel(muxChannel) || !charger.attach()) return -1;
+        
+        uint8_t index = _deviceCount++;
+        _devices[index] = &charger;
+        _channels[index] = muxChannel;
+        
+        // Keep the poll order sorted by mux channel so polls switch rarely
+        uint8_t pos = index;
+        while (pos > 0 && _channels[_order[pos - 1]] > muxChannel) {
+            _order[pos] = _order[pos - 1];
+            pos--;
+        }
+        _order[pos] = index;
+        return index;
+    }
+    
+    /**
+     * Get the number of registered chargers
+     * @return Device count
+     */
+    uint8_t deviceCount() const {
+        return _deviceCount;
+    }
+    
+    /**
+     * Select a charger's mux channel for direct register access
+     * Use the result only while it is in scope, e.g.
+     * if (auto charger = bus.access(0)) charger->setChargeCurrent(1000);
+     * @param index Device index
+     * @return Scoped access, false if the index is invalid or the select failed
+     */
+    Access access(uint8_t index) {
+        lock();
+        BQ25723* charger = nullptr;
+        if (index < _deviceCount && selectChannel(_channels[index])) charger = _devices[index];
+        return Access(this, charger);
+    }
+    
+    /**
+     * Poll one charger per call, cycling through all devices
+     * @param telemetry Pointer to store the decoded values
+     * @param index Optional pointer receiving the polled device index
+     * @return true if the poll succeeded
+     */
+    bool pollNext(BQ25723Telemetry* telemetry, uint8_t* index = nullptr) {
+        Lock guard(*this);
+        if (_deviceCount == 0) return false;
+        if (_next >= _deviceCount) _next = 0;
+        
+        uint8_t current = _order[_next++];
+        if (index) *index = current;
+        
+        Access charger = access(current);
+        return charger && charger->readTelemetry(telemetry);
+    }
+    
+    /**
+     * Poll every charger with one burst each, grouped by mux channel
+     * @param telemetry Array of deviceCount() entries, indexed by device index
+     * @return Bit mask of devices polled successfully
+     */
+    uint32_t pollAll(BQ25723Telemetry* telemetry) {
+        uint32_t okMask = 0;
+        if (!telemetry) return 0;
+        
+        Lock guard(*this);
+        for (uint8_t i = 0; i < _deviceCount; i++) {
+            uint8_t index = _order[i];
+            Access charger = access(index);
+            if (charger && charger->readTelemetry(&telemetry[index])) {
+                okMask |= (1UL << index);
+            }
+        }
+        return okMask;
+    }
+    
+    /**
+     * Recover a stuck bus for all chargers
+     * Clears the bus (BQ25723WireTransport::clearBus()), reinitializes the
+     * peripheral with this manager's pins and clock, then reselects each
+     * charger's mux channel and attaches to it again. Cached registers are
+     * dropped, since a charger may have reset; restore configurations with
+     * applyConfig() on the chargers that need it.
+     * @return Bit mask of devices that answered afterwards
+     */
+    uint32_t recover() {
+        Lock guard(*this);
+        if (!_initialized) return 0;
+        
+        _wire->end();
+        BQ25723WireTransport::clearBus(_sdaPin, _sclPin);
+        if (_sdaPin >= 0 && _sclPin >= 0) {
+            _wire->begin(_sdaPin, _sclPin);
+        } else {
+            _wire->begin();
+        }
+        _wire->setClock(_i2cSpeed);
+        _muxChannel = BQ25723_MUX_NONE;
+        
+        uint32_t okMask = 0;
+        for (uint8_t i = 0; i < _deviceCount; i++) {
+            uint8_t index = _order[i];
+            Access charger = access(index);
+            if (!charger) continue;
+            charger->invalidateCache();
+            if (charger->attach()) okMask |= (1UL << index);
+        }
+        return okMask;
+    }
+    
+    /**
+     * Forget the selected mux channel (e.g. after the mux was reset)
+     */
+    void invalidateMux() {
+        Lock guard(*this);
+        _muxChannel = BQ25723_MUX_NONE;
+    }
+};
+
+#endif // BQ25723_BUS_HPP
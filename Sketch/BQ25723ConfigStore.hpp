@@ -0,0 +1,113 @@
+/**
+ * BQ25723ConfigStore.hpp
+ *
+ * NVS persistence for BQ25723 configuration snapshots on the ESP32
+ * Stores a BQ25723Config captured by saveConfig() under a Preferences key,
+ * so it can be restored with applyConfig() after a brownout or reset.
+ */
+
+#ifndef BQ25723_CONFIG_STORE_HPP
+#define BQ25723_CONFIG_STORE_HPP
+
+#if defined(ESP32)
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include "BQ25723.hpp"
+
+// Default Preferences namespace and key
+#define BQ25723_CONFIG_NAMESPACE "bq25723"
+#define BQ25723_CONFIG_KEY       "config"
+
+// Stored record layout version; bump when BQ25723Config changes
+#define BQ25723_CONFIG_VERSION 1
+
+class BQ25723ConfigStore {
+private:
+    const char* _namespace;
+    const char* _key;
+    
+    struct Record {
+        uint8_t version;
+        uint8_t length;     // sizeof(BQ25723Config) when written
+        BQ25723Config config;
+    };
+    
+public:
+    /**
+     * Constructor
+     * @param ns Preferences namespace (at most 15 characters)
+     * @param key Preferences key (at most 15 characters)
+     */
+    explicit BQ25723ConfigStore(const char* ns = BQ25723_CONFIG_NAMESPACE,
+                                const char* key = BQ25723_CONFIG_KEY)
+        : _namespace(ns), _key(key) {}
+    
+    /**
+     * Write a configuration to NVS
+     * @param config Configuration to store (normally with a full validMask)
+     * @return true if the record was committed
+     */
+    bool save(const BQ25723Config& config) {
+        Record record;
+        record.version = BQ25723_CONFIG_VERSION;
+        record.length = sizeof(BQ25723Config);
+        record.config = config;
+        
+        Preferences prefs;
+        if (!prefs.begin(_namespace, false)) return false;
+        bool ok = (prefs.putBytes(_key, &record, sizeof(record)) == sizeof(record));
+        prefs.end();
+        return ok;
+    }
+    
+    /**
+     * Read a configuration from NVS
+     * Records written with another layout version are ignored.
+     * @param config Pointer to store the configuration
+     * @return true if a matching record was found
+     */
+    bool load(BQ25723Config* config) {
+        if (!config) return false;
+        
+        Record record;
+        Preferences prefs;
+        if (!prefs.begin(_namespace, true)) return false;
+        bool ok = (prefs.getBytesLength(_key) == sizeof(record)) &&
+                  (prefs.getBytes(_key, &record, sizeof(record)) == sizeof(record)) &&
+                  record.version == BQ25723_CONFIG_VERSION &&
+                  record.length == sizeof(BQ25723Config);
+        prefs.end();
+        
+        if (ok) *config = record.config;
+        return ok;
+    }
+    
+    /**
+     * Delete the stored configuration
+     * @return true if no record remains
+     */
+    bool clear() {
+        Preferences prefs;
+        if (!prefs.begin(_namespace, false)) return false;
+        if (prefs.isKey(_key)) prefs.remove(_key);
+        prefs.end();
+        return true;
+    }
+    
+    /**
+     * Restore the stored configuration to a charger
+     * @param charger Initialized driver
+     * @param written Optional pointer receiving the number of registers written
+     * @return true if a record was found and applied
+     */
+    bool restore(BQ25723& charger, uint8_t* written = nullptr) {
+        BQ25723Config config;
+        if (written) *written = 0;
+        return load(&config) && charger.applyConfig(config, written);
+    }
+};
+
+#endif // ESP32
+
+#endif // BQ25723_CONFIG_STORE_HPP
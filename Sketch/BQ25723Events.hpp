@@ -0,0 +1,320 @@
+/**
+ * BQ25723Events.hpp
+ *
+ * Interrupt-driven status handling for the BQ25723
+ * CHRG_OK and /PROCHOT edges trigger a deferred read of CHARGER_STATUS and
+ * PROCHOT_STATUS; changed bits are decoded and dispatched to callbacks. No
+ * I2C traffic is generated while the pins are idle.
+ */
+
+#ifndef BQ25723_EVENTS_HPP
+#define BQ25723_EVENTS_HPP
+
+#include <Arduino.h>
+#include "BQ25723.hpp"
+
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+// Delay before the event task retries a failed status read, in milliseconds
+#ifndef BQ25723_EVENTS_RETRY_MS
+#define BQ25723_EVENTS_RETRY_MS 10
+#endif
+
+// Decoded status change
+struct BQ25723StatusEvent {
+    uint16_t chargerStatus;    // CHARGER_STATUS after the change
+    uint16_t prochotStatus;    // PROCHOT_STATUS after the change
+    uint16_t chargerChanged;   // CHARGER_STATUS bits that toggled
+    uint16_t prochotChanged;   // PROCHOT_STATUS bits that toggled
+    
+    /**
+     * Check if the adapter is present (AC_STAT)
+     * @return true if the adapter is present
+     */
+    bool adapterPresent() const {
+        return BQ25723Fields::AC_STAT::get(chargerStatus) != 0;
+    }
+    
+    /**
+     * Get the fault bits that became set with this event
+     * @return BQ25723_FAULT_* bits
+     */
+    uint8_t newFaults() const {
+        return (uint8_t)BQ25723Fields::FAULTS::get(chargerStatus & chargerChanged);
+    }
+    
+    /**
+     * Get the PROCHOT trip sources that became set with this event
+     * @return BQ25723_PROCHOT_* bits
+     */
+    uint16_t newProchotTrips() const {
+        return BQ25723Fields::PROCHOT_STAT::get(prochotStatus & prochotChanged);
+    }
+};
+
+typedef void (*BQ25723StatusCallback)(const BQ25723StatusEvent& event, void* arg);
+
+class BQ25723Events {
+private:
+    BQ25723& _charger;
+    int _chrgOkPin;
+    int _prochotPin;
+    volatile bool _pending;
+    bool _haveStatus;
+    uint16_t _chargerStatus;
+    uint16_t _prochotStatus;
+    
+    BQ25723StatusCallback _onChange;
+    BQ25723StatusCallback _onAdapter;
+    BQ25723StatusCallback _onFault;
+    BQ25723StatusCallback _onProchot;
+    void* _onChangeArg;
+    void* _onAdapterArg;
+    void* _onFaultArg;
+    void* _onProchotArg;
+
+#if defined(ESP32)
+    TaskHandle_t _task;
+    
+    static void eventTask(void* param) {
+        BQ25723Events* self = static_cast<BQ25723Events*>(param);
+        for (;;) {
+            // A failed read leaves the event pending; retry it after a delay
+            // instead of waiting for the next pin edge
+            TickType_t wait = self->_pending ? pdMS_TO_TICKS(BQ25723_EVENTS_RETRY_MS) : portMAX_DELAY;
+            ulTaskNotifyTake(pdTRUE, wait ? wait : 1);
+            self->process();
+        }
+    }
+    
+    static void IRAM_ATTR pinIsr(void* arg) {
+        static_cast<BQ25723Events*>(arg)->signalFromIsr();
+    }
+    
+    void IRAM_ATTR signalFromIsr() {
+        _pending = true;
+        if (_task) {
+            BaseType_t woken = pdFALSE;
+            vTaskNotifyGiveFromISR(_task, &woken);
+            portYIELD_FROM_ISR(woken);
+        }
+    }
+#else
+    // attachInterrupt() has no argument, so only one instance can own pins
+    static BQ25723Events*& instance() {
+        static BQ25723Events* active = nullptr;
+        return active;
+    }
+    
+    static void pinIsr() {
+        if (instance()) instance()->_pending = true;
+    }
+#endif
+
+    void attachPin(int pin, int mode) {
+        if (pin < 0) return;
+        pinMode(pin, INPUT_PULLUP);
+#if defined(ESP32)
+        attachInterruptArg(digitalPinToInterrupt(pin), pinIsr, this, mode);
+#else
+        attachInterrupt(digitalPinToInterrupt(pin), pinIsr, mode);
+#endif
+    }
+    
+    static void dispatch(BQ25723StatusCallback callback, void* arg, const BQ25723StatusEvent& event) {
+        if (callback) callback(event, arg);
+    }
+    
+public:
+    /**
+     * Constructor
+     * @param charger Initialized driver to read status from
+     */
+    explicit BQ25723Events(BQ25723& charger)
+        : _charger(charger), _chrgOkPin(-1), _prochotPin(-1), _pending(false),
+          _haveStatus(false), _chargerStatus(0), _prochotStatus(0),
+          _onChange(nullptr), _onAdapter(nullptr), _onFault(nullptr), _onProchot(nullptr),
+          _onChangeArg(nullptr), _onAdapterArg(nullptr), _onFaultArg(nullptr), _onProchotArg(nullptr)
+#if defined(ESP32)
+          , _task(nullptr)
+#endif
+          {}
+    
+    ~BQ25723Events() {
+        end();
+    }
+    
+    /**
+     * Attach interrupts to the status pins
+     * The first process() call always reads the status and reports every bit
+     * as changed, establishing a baseline.
+     * @param chrgOkPin GPIO wired to CHRG_OK (-1 if not connected)
+     * @param prochotPin GPIO wired to /PROCHOT (-1 if not connected)
+     * @return true if at least one pin is attached
+     */
+    bool begin(int chrgOkPin, int prochotPin = -1) {
+        end();
+        _chrgOkPin = chrgOkPin;
+        _prochotPin = prochotPin;
+        _haveStatus = false;
+        _pending = true;
+#if !defined(ESP32)
+        instance() = this;
+#endif
+        attachPin(_chrgOkPin, CHANGE);     // Adapter plugged or removed
+        attachPin(_prochotPin, FALLING);   // Active-low PROCHOT pulse
+        return (_chrgOkPin >= 0 || _prochotPin >= 0);
+    }
+    
+    /**
+     * Detach interrupts and stop the event task
+     */
+    void end() {
+        if (_chrgOkPin >= 0) detachInterrupt(digitalPinToInterrupt(_chrgOkPin));
+        if (_prochotPin >= 0) detachInterrupt(digitalPinToInterrupt(_prochotPin));
+        _chrgOkPin = -1;
+        _prochotPin = -1;
+#if defined(ESP32)
+        if (_task) {
+            vTaskDelete(_task);
+            _task = nullptr;
+        }
+#else
+        if (instance() == this) instance() = nullptr;
+#endif
+    }
+
+#if defined(ESP32)
+    /**
+     * Run process() from a dedicated task woken by the pin interrupts
+     * Callbacks then run on that task. A failed status read is retried
+     * every BQ25723_EVENTS_RETRY_MS until it succeeds.
+     * @param priority FreeRTOS priority of the task
+     * @param core Core to pin the task to (default no affinity)
+     * @param stackSize Task stack size in bytes
+     * @return true if the task is running
+     */
+    bool startTask(UBaseType_t priority = 5, BaseType_t core = tskNO_AFFINITY,
+                   uint32_t stackSize = 3072) {
+        if (_task) return true;
+        if (xTaskCreatePinnedToCore(eventTask, "bq25723_evt", stackSize, this,
+                                    priority, &_task, core) != pdPASS) {
+            _task = nullptr;
+            return false;
+        }
+        if (_pending) xTaskNotifyGive(_task);
+        return true;
+    }
+#endif
+
+    /**
+     * Request a status read on the next process() call
+     */
+    void trigger() {
+        _pending = true;
+#if defined(ESP32)
+        if (_task) xTaskNotifyGive(_task);
+#endif
+    }
+    
+    /**
+     * Read and dispatch status changes if a pin edge was seen
+     * Call from loop() when no event task is running; returns immediately
+     * without bus traffic when nothing is pending.
+     * @return true if the status registers were read
+     */
+    bool process() {
+        if (!_pending) return false;
+        _pending = false;
+        
+        uint16_t status[2];
+        if (_charger.readMultipleRegisters(BQ25723_REG_CHARGER_STATUS, status, 2) != 2) {
+            _pending = true; // Retry on the next call
+            return false;
+        }
+        
+        BQ25723StatusEvent event;
+        event.chargerStatus = status[0];
+        event.prochotStatus = status[1];
+        event.chargerChanged = _haveStatus ? (status[0] ^ _chargerStatus) : 0xFFFF;
+        event.prochotChanged = _haveStatus ? (status[1] ^ _prochotStatus) : 0xFFFF;
+        _chargerStatus = status[0];
+        _prochotStatus = status[1];
+        _haveStatus = true;
+        
+        if (!event.chargerChanged && !event.prochotChanged) return true;
+        
+        dispatch(_onChange, _onChangeArg, event);
+        if (event.chargerChanged & BQ25723Fields::AC_STAT::mask) {
+            dispatch(_onAdapter, _onAdapterArg, event);
+        }
+        if (event.newFaults()) {
+            dispatch(_onFault, _onFaultArg, event);
+        }
+        if (event.newProchotTrips()) {
+            dispatch(_onProchot, _onProchotArg, event);
+        }
+        return true;
+    }
+    
+    /**
+     * Set a callback for any status bit change
+     * @param callback Function to call, or nullptr to remove
+     * @param arg Argument passed to the callback
+     */
+    void onStatusChange(BQ25723StatusCallback callback, void* arg = nullptr) {
+        _onChange = callback;
+        _onChangeArg = arg;
+    }
+    
+    /**
+     * Set a callback for adapter insertion/removal (AC_STAT changes)
+     * @param callback Function to call, or nullptr to remove
+     * @param arg Argument passed to the callback
+     */
+    void onAdapterChange(BQ25723StatusCallback callback, void* arg = nullptr) {
+        _onAdapter = callback;
+        _onAdapterArg = arg;
+    }
+    
+    /**
+     * Set a callback for newly set CHARGER_STATUS fault bits
+     * @param callback Function to call, or nullptr to remove
+     * @param arg Argument passed to the callback
+     */
+    void onFault(BQ25723StatusCallback callback, void* arg = nullptr) {
+        _onFault = callback;
+        _onFaultArg = arg;
+    }
+    
+    /**
+     * Set a callback for newly set PROCHOT_STATUS trip bits
+     * @param callback Function to call, or nullptr to remove
+     * @param arg Argument passed to the callback
+     */
+    void onProchot(BQ25723StatusCallback callback, void* arg = nullptr) {
+        _onProchot = callback;
+        _onProchotArg = arg;
+    }
+    
+    /**
+     * Get the last CHARGER_STATUS value read
+     * @return Register value (0 before the first read)
+     */
+    uint16_t getChargerStatus() const {
+        return _chargerStatus;
+    }
+    
+    /**
+     * Get the last PROCHOT_STATUS value read
+     * @return Register value (0 before the first read)
+     */
+    uint16_t getProchotStatus() const {
+        return _prochotStatus;
+    }
+};
+
+#endif // BQ25723_EVENTS_HPP
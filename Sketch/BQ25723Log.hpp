@@ -0,0 +1,324 @@
+/**
+ * BQ25723Log.hpp
+ *
+ * Compact binary telemetry log for BQ25723 register snapshots
+ * A keyframe stores every valid register; following delta records store only
+ * the bytes that changed, addressed by a two-level bitmap. Records stream to
+ * any Print (Serial, a SPIFFS/LittleFS File, or a caller buffer via
+ * BQ25723BufferPrint) and decode from a byte buffer.
+ *
+ * Keyframe: 0xB1, timestamp (u32 LE, ms), valid mask (u32 LE),
+ *           2 bytes (LSB, MSB) per valid register in address order
+ * Delta:    0xB2, timestamp delta (LEB128 varint, ms), group mask (u8),
+ *           one change mask per set group, then the changed bytes in order
+ * Snapshot byte n is register 2 * (n / 2), LSB when n is even; group g
+ * covers snapshot bytes 8g to 8g + 7.
+ */
+
+#ifndef BQ25723_LOG_HPP
+#define BQ25723_LOG_HPP
+
+#include <Arduino.h>
+#include "BQ25723.hpp"
+
+#define BQ25723_LOG_KEYFRAME  0xB1
+#define BQ25723_LOG_DELTA     0xB2
+
+// Records between forced keyframes (for resynchronizing mid-stream)
+#ifndef BQ25723_LOG_KEYFRAME_INTERVAL
+#define BQ25723_LOG_KEYFRAME_INTERVAL 64
+#endif
+
+// Largest encoded record: delta with every byte changed
+#define BQ25723_LOG_MAX_RECORD (1 + 5 + 1 + 8 + 2 * BQ25723_REG_COUNT)
+
+// Timestamped register snapshot
+struct BQ25723LogSnapshot {
+    uint32_t timestampMs;
+    BQ25723RegisterMap registers;
+};
+
+/**
+ * Print adapter writing into a caller-provided buffer
+ * Bytes beyond the buffer are discarded and reported by overflowed().
+ */
+class BQ25723BufferPrint : public Print {
+private:
+    uint8_t* _buffer;
+    size_t _capacity;
+    size_t _length;
+    bool _overflow;
+    
+public:
+    BQ25723BufferPrint(uint8_t* buffer, size_t capacity)
+        : _buffer(buffer), _capacity(capacity), _length(0), _overflow(false) {}
+    
+    size_t write(uint8_t c) override {
+        return write(&c, 1);
+    }
+    
+    size_t write(const uint8_t* data, size_t size) override {
+        if (_length + size > _capacity) {
+            _overflow = true;
+            return 0;
+        }
+        memcpy(_buffer + _length, data, size);
+        _length += size;
+        return size;
+    }
+    
+    /**
+     * Get the number of bytes stored
+     * @return Byte count
+     */
+    size_t length() const {
+        return _length;
+    }
+    
+    /**
+     * Check if a write did not fit
+     * @return true if data was discarded
+     */
+    bool overflowed() const {
+        return _overflow;
+    }
+    
+    /**
+     * Discard the buffered bytes
+     */
+    void clear() {
+        _length = 0;
+        _overflow = false;
+    }
+};
+
+class BQ25723LogEncoder {
+private:
+    Print& _out;
+    uint16_t _keyframeInterval;
+    uint16_t _sinceKeyframe;
+    bool _haveReference;
+    BQ25723LogSnapshot _reference;
+    
+    static uint8_t snapshotByte(const BQ25723RegisterMap& map, uint8_t n) {
+        uint16_t word = map.words[n >> 1];
+        return (n & 1) ? (word >> 8) : (word & 0xFF);
+    }
+    
+    static uint8_t putU32(uint8_t* p, uint32_t v) {
+        p[0] = v & 0xFF;
+        p[1] = (v >> 8) & 0xFF;
+        p[2] = (v >> 16) & 0xFF;
+        p[3] = (v >> 24) & 0xFF;
+        return 4;
+    }
+    
+    static uint8_t putVarint(uint8_t* p, uint32_t v) {
+        uint8_t n = 0;
+        while (v >= 0x80) {
+            p[n++] = (v & 0x7F) | 0x80;
+            v >>= 7;
+        }
+        p[n++] = v;
+        return n;
+    }
+    
+    size_t encodeKeyframe(const BQ25723LogSnapshot& snapshot, uint8_t* record) {
+        size_t n = 0;
+        record[n++] = BQ25723_LOG_KEYFRAME;
+        n += putU32(&record[n], snapshot.timestampMs);
+        n += putU32(&record[n], snapshot.registers.validMask);
+        for (uint8_t slot = 0; slot < BQ25723_REG_COUNT; slot++) {
+            if (snapshot.registers.validMask & (1UL << slot)) {
+                record[n++] = snapshot.registers.words[slot] & 0xFF;
+                record[n++] = snapshot.registers.words[slot] >> 8;
+            }
+        }
+        return n;
+    }
+    
+    size_t encodeDelta(const BQ25723LogSnapshot& snapshot, uint8_t* record) {
+        uint8_t changes[BQ25723_REG_COUNT / 4] = { 0 };   // One bit per snapshot byte
+        uint8_t groups = 0;
+        
+        for (uint8_t b = 0; b < 2 * BQ25723_REG_COUNT; b++) {
+            if ((snapshot.registers.validMask & (1UL << (b >> 1))) &&
+                snapshotByte(snapshot.registers, b) != snapshotByte(_reference.registers, b)) {
+                changes[b >> 3] |= (1 << (b & 7));
+                groups |= (1 << (b >> 3));
+            }
+        }
+        
+        size_t n = 0;
+        record[n++] = BQ25723_LOG_DELTA;
+        n += putVarint(&record[n], snapshot.timestampMs - _reference.timestampMs);
+        record[n++] = groups;
+        for (uint8_t g = 0; g < sizeof(changes); g++) {
+            if (groups & (1 << g)) record[n++] = changes[g];
+        }
+        for (uint8_t b = 0; b < 2 * BQ25723_REG_COUNT; b++) {
+            if (changes[b >> 3] & (1 << (b & 7))) {
+                record[n++] = snapshotByte(snapshot.registers, b);
+            }
+        }
+        return n;
+    }
+    
+public:
+    /**
+     * Constructor
+     * @param out Destination for encoded records
+     * @param keyframeInterval Records between forced keyframes
+     */
+    explicit BQ25723LogEncoder(Print& out, uint16_t keyframeInterval = BQ25723_LOG_KEYFRAME_INTERVAL)
+        : _out(out), _keyframeInterval(keyframeInterval), _sinceKeyframe(0), _haveReference(false) {}
+    
+    /**
+     * Encode one snapshot as a keyframe or delta record
+     * A keyframe is written first, every keyframeInterval records, when the
+     * set of valid registers changes, or when time runs backwards.
+     * @param snapshot Snapshot to encode
+     * @return Number of bytes written, 0 if the sink rejected the record
+     */
+    size_t write(const BQ25723LogSnapshot& snapshot) {
+        uint8_t record[BQ25723_LOG_MAX_RECORD];
+        size_t length;
+        
+        bool keyframe = !_haveReference || _sinceKeyframe >= _keyframeInterval ||
+                        snapshot.registers.validMask != _reference.registers.validMask ||
+                        snapshot.timestampMs < _reference.timestampMs;
+        if (keyframe) {
+            length = encodeKeyframe(snapshot, record);
+            _sinceKeyframe = 0;
+        } else {
+            length = encodeDelta(snapshot, record);
+        }
+        
+        if (_out.write(record, length) != length) {
+            _haveReference = false; // Restart with a keyframe
+            return 0;
+        }
+        _sinceKeyframe++;
+        _reference = snapshot;
+        _haveReference = true;
+        return length;
+    }
+    
+    /**
+     * Force the next record to be a keyframe (e.g. when starting a new file)
+     */
+    void reset() {
+        _haveReference = false;
+    }
+};
+
+class BQ25723LogDecoder {
+private:
+    bool _haveReference;
+    BQ25723LogSnapshot _state;
+    
+    static uint32_t getU32(const uint8_t* p) {
+        return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+    
+    static void setSnapshotByte(BQ25723RegisterMap& map, uint8_t n, uint8_t value) {
+        uint16_t& word = map.words[n >> 1];
+        word = (n & 1) ? ((word & 0x00FF) | (value << 8)) : ((word & 0xFF00) | value);
+    }
+    
+    size_t decodeKeyframe(const uint8_t* data, size_t length) {
+        if (length < 9) return 0;
+        
+        uint32_t validMask = getU32(&data[5]);
+        size_t n = 9;
+        for (uint8_t slot = 0; slot < BQ25723_REG_COUNT; slot++) {
+            if (validMask & (1UL << slot)) n += 2;
+        }
+        if (n > length) return 0;
+        
+        n = 9;
+        for (uint8_t slot = 0; slot < BQ25723_REG_COUNT; slot++) {
+            if (!(validMask & (1UL << slot))) continue;
+            _state.registers.words[slot] = data[n] | (data[n + 1] << 8);
+            n += 2;
+        }
+        _state.timestampMs = getU32(&data[1]);
+        _state.registers.validMask = validMask;
+        _haveReference = true;
+        return n;
+    }
+    
+    size_t decodeDelta(const uint8_t* data, size_t length) {
+        size_t n = 1;
+        uint32_t delta = 0;
+        for (uint8_t shift = 0; ; shift += 7) {
+            if (n >= length || shift > 28) return 0;
+            uint8_t b = data[n++];
+            delta |= (uint32_t)(b & 0x7F) << shift;
+            if (!(b & 0x80)) break;
+        }
+        
+        if (n >= length) return 0;
+        uint8_t groups = data[n++];
+        uint8_t changes[BQ25723_REG_COUNT / 4] = { 0 };
+        for (uint8_t g = 0; g < sizeof(changes); g++) {
+            if (!(groups & (1 << g))) continue;
+            if (n >= length) return 0;
+            changes[g] = data[n++];
+        }
+        
+        // Apply to a copy so a truncated record leaves the state untouched
+        BQ25723LogSnapshot next = _state;
+        for (uint8_t b = 0; b < 2 * BQ25723_REG_COUNT; b++) {
+            if (!(changes[b >> 3] & (1 << (b & 7)))) continue;
+            if (n >= length) return 0;
+            setSnapshotByte(next.registers, b, data[n++]);
+        }
+        next.timestampMs += delta;
+        if (_haveReference) _state = next;
+        return n;
+    }
+    
+public:
+    BQ25723LogDecoder() : _haveReference(false) {}
+    
+    /**
+     * Decode the record at the start of a buffer
+     * Deltas seen before the first keyframe are consumed without producing a
+     * snapshot (isSynchronized() stays false).
+     * @param data Encoded bytes
+     * @param length Number of bytes available
+     * @param snapshot Pointer to store the reconstructed snapshot
+     * @return Bytes consumed, or 0 if the record is incomplete or the tag is
+     *         unknown (skip one byte to resynchronize)
+     */
+    size_t decode(const uint8_t* data, size_t length, BQ25723LogSnapshot* snapshot) {
+        if (!data || length == 0 || !snapshot) return 0;
+        
+        size_t n;
+        switch (data[0]) {
+            case BQ25723_LOG_KEYFRAME: n = decodeKeyframe(data, length); break;
+            case BQ25723_LOG_DELTA:    n = decodeDelta(data, length); break;
+            default:                   n = 0; break;
+        }
+        if (n && _haveReference) *snapshot = _state;
+        return n;
+    }
+    
+    /**
+     * Check if a keyframe has been decoded
+     * @return true once decode() produces snapshots
+     */
+    bool isSynchronized() const {
+        return _haveReference;
+    }
+    
+    /**
+     * Forget the reference snapshot; decoding resumes at the next keyframe
+     */
+    void reset() {
+        _haveReference = false;
+    }
+};
+
+#endif // BQ25723_LOG_HPP
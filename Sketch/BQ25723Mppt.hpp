@@ -0,0 +1,173 @@
+/**
+ * BQ25723Mppt.hpp
+ *
+ * Perturb-and-observe input power tracking for the BQ25723
+ * Each step computes the input power from one ADC snapshot (VBUS x IIN),
+ * compares it with the previous step and moves one input limit by a fixed
+ * number of codes: uphill in the same direction, downhill reversed. Track
+ * INPUT_VOLTAGE (VINDPM) for solar panels, or IIN_HOST for weak adapters.
+ *
+ * New limits go through writeField(). With the shadow cache enabled
+ * (enableCache()), the new word is computed from the cached register, so a
+ * step costs at most one write, and steps that hold or stay pinned at a
+ * range limit generate no bus traffic at all. The ADC must convert VBUS
+ * and IIN continuously (see begin()). Steps run from update() at a fixed
+ * rate, or from step() with snapshots the application already has (for
+ * example from BQ25723Sampler).
+ */
+
+#ifndef BQ25723_MPPT_HPP
+#define BQ25723_MPPT_HPP
+
+#include <Arduino.h>
+#include "BQ25723.hpp"
+
+/**
+ * Input power tracker
+ * @tparam Field Limit to perturb, BQ25723Fields::INPUT_VOLTAGE or
+ *               BQ25723Fields::IIN_HOST
+ */
+template <typename Field>
+class BQ25723Mppt {
+private:
+    BQ25723& _charger;
+    uint16_t _minCode;
+    uint16_t _maxCode;
+    uint16_t _code;
+    uint16_t _stepCodes;
+    uint16_t _deadband_mW;      // Power changes this small count as no change
+    int8_t _direction;          // +1 raises the limit, -1 lowers it
+    bool _havePower;
+    uint32_t _power_mW;
+    uint32_t _periodMs;
+    uint32_t _lastStepMs;
+    
+public:
+    /**
+     * Constructor
+     * @param charger Initialized driver
+     */
+    explicit BQ25723Mppt(BQ25723& charger)
+        : _charger(charger), _minCode(0), _maxCode(Field::maxCode), _code(0), _stepCodes(1),
+          _deadband_mW(0), _direction(1), _havePower(false), _power_mW(0),
+          _periodMs(100), _lastStepMs(0) {}
+    
+    /**
+     * Set the tracking range and starting point, and program the start value
+     * @param minValue Lowest limit in mV or mA
+     * @param maxValue Highest limit in mV or mA
+     * @param startValue First limit to apply, clamped to the range
+     * @param periodMs Interval between update() steps in milliseconds
+     * @param continuousAdc true to start continuous conversions with VBUS and
+     *                      IIN added to the channels already enabled
+     * @return true if the ADC and start value were programmed
+     */
+    bool begin(uint16_t minValue, uint16_t maxValue, uint16_t startValue,
+               uint32_t periodMs = 100, bool continuousAdc = true) {
+        _minCode = Field::fromValue(minValue);
+        _maxCode = Field::fromValue(maxValue);
+        if (_maxCode < _minCode) _maxCode = _minCode;
+        _code = Field::fromValue(startValue);
+        if (_code < _minCode) _code = _minCode;
+        if (_code > _maxCode) _code = _maxCode;
+        _periodMs = periodMs;
+        _direction = 1;
+        _havePower = false;
+        _lastStepMs = millis();
+        
+        if (continuousAdc) {
+            // Add VBUS and IIN to the enabled channels; others stay as configured
+            using namespace BQ25723Fields;
+            uint16_t channels = EN_ADC::encode(BQ25723_ADC_CH_VBUS | BQ25723_ADC_CH_IIN);
+            if (!_charger.updateBits(BQ25723_REG_ADC_OPTION,
+                                     ADC_CONV::mask | ADC_START::mask | ADC_FULLSCALE::mask | channels,
+                                     ADC_CONV::encode(BQ25723_ADC_CONTINUOUS) | ADC_START::encode(1) |
+                                     ADC_FULLSCALE::encode(1) | channels)) {
+                return false;
+            }
+        }
+        return _charger.writeField<Field>(_code);
+    }
+    
+    /**
+     * Set the perturbation size
+     * @param codes Field codes moved per step (at least 1)
+     */
+    void setStepSize(uint16_t codes) {
+        _stepCodes = codes ? codes : 1;
+    }
+    
+    /**
+     * Set the power change treated as noise; the limit holds while the
+     * power stays within this band of the previous step
+     * @param mW Dead band in milliwatts
+     */
+    void setDeadband(uint16_t mW) {
+        _deadband_mW = mW;
+    }
+    
+    /**
+     * Run one tracking step on an ADC snapshot
+     * @param reading ADC results with VBUS and IIN converted
+     * @return true unless writing the new limit failed
+     */
+    bool step(const BQ25723AdcReading& reading) {
+        uint32_t power = (uint32_t)reading.vbus_mV * reading.iin_mA / 1000;
+        
+        if (_havePower) {
+            if (power + _deadband_mW < _power_mW) {
+                _direction = -_direction;   // Went downhill: turn around
+            } else if (power <= _power_mW + _deadband_mW) {
+                return true;                // Flat: hold until the power moves
+            }
+        }
+        _power_mW = power;
+        _havePower = true;
+        
+        int32_t next = (int32_t)_code + _direction * (int32_t)_stepCodes;
+        if (next <= (int32_t)_minCode) {
+            next = _minCode;
+            _direction = 1;
+        } else if (next >= (int32_t)_maxCode) {
+            next = _maxCode;
+            _direction = -1;
+        }
+        if ((uint16_t)next == _code) return true;
+        _code = (uint16_t)next;
+        return _charger.writeField<Field>(_code);
+    }
+    
+    /**
+     * Read an ADC snapshot and step once every period; call from loop()
+     * @return true if a step ran successfully
+     */
+    bool update() {
+        uint32_t now = millis();
+        if (now - _lastStepMs < _periodMs) return false;
+        _lastStepMs = now;
+        
+        BQ25723AdcReading reading;
+        return _charger.readAdc(&reading) && step(reading);
+    }
+    
+    /**
+     * Get the limit currently programmed
+     * @return Limit in mV or mA
+     */
+    uint16_t getValue() const {
+        return Field::toValue(_code);
+    }
+    
+    /**
+     * Get the input power measured at the last perturbation
+     * @return Power in milliwatts (0 before the first step)
+     */
+    uint32_t getPower_mW() const {
+        return _power_mW;
+    }
+};
+
+typedef BQ25723Mppt<BQ25723Fields::INPUT_VOLTAGE> BQ25723VinMppt;   // Solar panels
+typedef BQ25723Mppt<BQ25723Fields::IIN_HOST> BQ25723IinMppt;        // Weak adapters
+
+#endif // BQ25723_MPPT_HPP
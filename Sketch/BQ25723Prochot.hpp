@@ -0,0 +1,190 @@
+/**
+ * BQ25723Prochot.hpp
+ *
+ * Hardware PROCHOT thresholds for the BQ25723
+ * Programs the comparators behind /PROCHOT (PROCHOT_OPTION_0/1 and the pulse
+ * settings in PROCHOT_STATUS) so overload detection runs in the charger
+ * instead of in software polling PSYS or IIN. Trips are reported through
+ * BQ25723Events: with /PROCHOT wired to the events prochotPin, the status is
+ * read only when the pin asserts.
+ *
+ * Input power budgets map onto INOM (input current above IIN_DPM) and ICRIT
+ * (ILIM2_VTH percent of IIN_DPM); battery discharge onto IDCHG_VTH.
+ */
+
+#ifndef BQ25723_PROCHOT_HPP
+#define BQ25723_PROCHOT_HPP
+
+#include <Arduino.h>
+#include "BQ25723.hpp"
+#include "BQ25723Events.hpp"
+
+// ICRIT deglitch time (ICRIT_DEG)
+enum BQ25723IcritDeglitch : uint8_t {
+    BQ25723_ICRIT_DEG_15US  = 0,
+    BQ25723_ICRIT_DEG_100US = 1,
+    BQ25723_ICRIT_DEG_400US = 2,
+    BQ25723_ICRIT_DEG_800US = 3
+};
+
+// IDCHG1 deglitch time (IDCHG_DEG)
+enum BQ25723IdchgDeglitch : uint8_t {
+    BQ25723_IDCHG_DEG_78MS   = 0,
+    BQ25723_IDCHG_DEG_1250MS = 1,
+    BQ25723_IDCHG_DEG_5S     = 2,
+    BQ25723_IDCHG_DEG_10S    = 3
+};
+
+// /PROCHOT pulse width in one-shot mode (PROCHOT_WIDTH)
+enum BQ25723ProchotWidth : uint8_t {
+    BQ25723_PROCHOT_WIDTH_100US = 0,
+    BQ25723_PROCHOT_WIDTH_1MS   = 1,
+    BQ25723_PROCHOT_WIDTH_10MS  = 2,
+    BQ25723_PROCHOT_WIDTH_5MS   = 3
+};
+
+// PROCHOT sources that can assert the pin (PROCHOT_PROFILE, bits 7:0)
+#define BQ25723_PROCHOT_PROFILE_MASK 0xFF
+
+// PROCHOT thresholds, deglitch times and source mask
+struct BQ25723ProchotConfig {
+    uint8_t profile;               // BQ25723_PROCHOT_* sources enabled on /PROCHOT
+    uint16_t ilim2Percent;         // ICRIT threshold, 110-260 % of IIN_DPM in 5 % steps
+    uint8_t icritDeglitch;         // BQ25723IcritDeglitch
+    bool inomDeglitchLong;         // INOM deglitch: false 1 ms, true 60 ms
+    uint16_t idchgThreshold_mA;    // IDCHG1 battery discharge threshold (0 disables)
+    uint8_t idchgDeglitch;         // BQ25723IdchgDeglitch
+    uint8_t vsysCode;              // VSYS_VTH code (threshold depends on cell count)
+    uint8_t width;                 // BQ25723ProchotWidth
+    bool extended;                 // Hold /PROCHOT low until release() (EN_PROCHOT_EXT)
+};
+
+// Trip callback: trips holds the BQ25723_PROCHOT_* sources that became set
+typedef void (*BQ25723ProchotCallback)(uint16_t trips, void* arg);
+
+class BQ25723Prochot {
+private:
+    BQ25723& _charger;
+    BQ25723ProchotCallback _onTrip;
+    void* _onTripArg;
+    uint16_t _lastTrips;
+    uint32_t _tripCount;
+    
+    static void handleEvent(const BQ25723StatusEvent& event, void* arg) {
+        BQ25723Prochot* self = static_cast<BQ25723Prochot*>(arg);
+        uint16_t trips = event.newProchotTrips();
+        self->_lastTrips = trips;
+        self->_tripCount++;
+        if (self->_onTrip) self->_onTrip(trips, self->_onTripArg);
+    }
+    
+public:
+    /**
+     * Constructor
+     * @param charger Initialized driver
+     */
+    explicit BQ25723Prochot(BQ25723& charger)
+        : _charger(charger), _onTrip(nullptr), _onTripArg(nullptr), _lastTrips(0), _tripCount(0) {}
+    
+    /**
+     * Program thresholds, deglitch times and the source mask
+     * Both option registers are read and written back in one burst each;
+     * the pulse settings need one read-modify-write of PROCHOT_STATUS.
+     * @param config Settings to apply
+     * @return true if all registers were written, false on a bus error or an
+     *         ilim2Percent outside 110-260
+     */
+    bool configure(const BQ25723ProchotConfig& config) {
+        using namespace BQ25723Fields;
+        if (config.ilim2Percent < ILIM2_VTH::toValue(1) ||   // Code 0 is reserved
+            config.ilim2Percent > ILIM2_VTH::toValue(ILIM2_VTH::maxCode)) {
+            return false;
+        }
+        
+        uint16_t words[2];
+        if (_charger.readMultipleRegisters(BQ25723_REG_PROCHOT_OPTION_0, words, 2) != 2) {
+            return false;
+        }
+        words[0] = ILIM2_VTH::set(words[0], ILIM2_VTH::fromValue(config.ilim2Percent));
+        words[0] = ICRIT_DEG::set(words[0], config.icritDeglitch);
+        words[0] = VSYS_VTH::set(words[0], config.vsysCode);
+        words[0] = INOM_DEG::set(words[0], config.inomDeglitchLong);
+        words[1] = IDCHG_VTH::set(words[1], IDCHG_VTH::fromValue(config.idchgThreshold_mA));
+        words[1] = IDCHG_DEG::set(words[1], config.idchgDeglitch);
+        words[1] = PROCHOT_PROFILE::set(words[1], config.profile);
+        if (_charger.writeMultipleRegisters(BQ25723_REG_PROCHOT_OPTION_0, words, 2) != 2) {
+            return false;
+        }
+        
+        uint16_t pulse = PROCHOT_WIDTH::encode(config.width) | EN_PROCHOT_EXT::encode(config.extended);
+        return _charger.updateBits(BQ25723_REG_PROCHOT_STATUS,
+                                   PROCHOT_WIDTH::mask | EN_PROCHOT_EXT::mask, pulse);
+    }
+    
+    /**
+     * Read the current settings back from the device
+     * @param config Pointer to store the settings
+     * @return true if all registers were read
+     */
+    bool readConfig(BQ25723ProchotConfig* config) {
+        using namespace BQ25723Fields;
+        if (!config) return false;
+        
+        uint16_t words[2];
+        uint16_t status;
+        if (_charger.readMultipleRegisters(BQ25723_REG_PROCHOT_OPTION_0, words, 2) != 2 ||
+            !_charger.readRegister(BQ25723_REG_PROCHOT_STATUS, &status)) {
+            return false;
+        }
+        config->profile = (uint8_t)PROCHOT_PROFILE::get(words[1]);
+        config->ilim2Percent = ILIM2_VTH::decode(words[0]);
+        config->icritDeglitch = (uint8_t)ICRIT_DEG::get(words[0]);
+        config->inomDeglitchLong = INOM_DEG::get(words[0]) != 0;
+        config->idchgThreshold_mA = IDCHG_VTH::decode(words[1]);
+        config->idchgDeglitch = (uint8_t)IDCHG_DEG::get(words[1]);
+        config->vsysCode = (uint8_t)VSYS_VTH::get(words[0]);
+        config->width = (uint8_t)PROCHOT_WIDTH::get(status);
+        config->extended = EN_PROCHOT_EXT::get(status) != 0;
+        return true;
+    }
+    
+    /**
+     * Report trips through an event handler
+     * Takes over the handler's onProchot() callback. Call events.begin()
+     * with the /PROCHOT pin so status is read only on assertion.
+     * @param events Event handler for this charger
+     * @param callback Function to call with the new trip sources
+     * @param arg Argument passed to the callback
+     */
+    void attach(BQ25723Events& events, BQ25723ProchotCallback callback, void* arg = nullptr) {
+        _onTrip = callback;
+        _onTripArg = arg;
+        events.onProchot(handleEvent, this);
+    }
+    
+    /**
+     * Release /PROCHOT held low in extended mode (PROCHOT_CLEAR)
+     * @return true if write successful
+     */
+    bool release() {
+        return _charger.writeField<BQ25723Fields::PROCHOT_CLEAR>(0);
+    }
+    
+    /**
+     * Get the sources reported by the last trip
+     * @return BQ25723_PROCHOT_* bits (0 before the first trip)
+     */
+    uint16_t getLastTrips() const {
+        return _lastTrips;
+    }
+    
+    /**
+     * Get the number of trips reported
+     * @return Count since construction
+     */
+    uint32_t getTripCount() const {
+        return _tripCount;
+    }
+};
+
+#endif // BQ25723_PROCHOT_HPP
@@ -0,0 +1,107 @@
+/**
+ * BQ25723Ring.hpp
+ *
+ * Fixed-size lock-free ring buffer
+ * One producer and one consumer may run on different tasks or cores. Storage
+ * is part of the object, so nothing is allocated at runtime.
+ */
+
+#ifndef BQ25723_RING_HPP
+#define BQ25723_RING_HPP
+
+#include <Arduino.h>
+
+/**
+ * Single-producer single-consumer ring buffer
+ * When full, push() rejects the new item and counts it as dropped.
+ * @tparam T Item type (copied by value)
+ * @tparam Capacity Number of items, a power of two
+ */
+template <typename T, uint16_t Capacity>
+class BQ25723Ring {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+                  
+private:
+    T _items[Capacity];
+    uint32_t _head;      // Next slot to write (producer only)
+    uint32_t _tail;      // Next slot to read (consumer only)
+    uint32_t _dropped;
+    
+public:
+    BQ25723Ring() : _head(0), _tail(0), _dropped(0) {}
+    
+    /**
+     * Append an item (producer side)
+     * @param item Item to copy in
+     * @return true if stored, false if the ring was full
+     */
+    bool push(const T& item) {
+        uint32_t head = __atomic_load_n(&_head, __ATOMIC_RELAXED);
+        uint32_t tail = __atomic_load_n(&_tail, __ATOMIC_ACQUIRE);
+        if (head - tail >= Capacity) {
+            __atomic_fetch_add(&_dropped, 1, __ATOMIC_RELAXED);
+            return false;
+        }
+        _items[head & (Capacity - 1)] = item;
+        __atomic_store_n(&_head, head + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+    
+    /**
+     * Remove the oldest item (consumer side)
+     * @param item Pointer to store the item
+     * @return true if an item was removed, false if the ring was empty
+     */
+    bool pop(T* item) {
+        return drain(item, 1) == 1;
+    }
+    
+    /**
+     * Remove up to maxItems of the oldest items (consumer side)
+     * @param items Array to store the items
+     * @param maxItems Capacity of the array
+     * @return Number of items removed
+     */
+    uint16_t drain(T* items, uint16_t maxItems) {
+        if (!items) return 0;
+        
+        uint32_t tail = __atomic_load_n(&_tail, __ATOMIC_RELAXED);
+        uint32_t head = __atomic_load_n(&_head, __ATOMIC_ACQUIRE);
+        uint32_t count = head - tail;
+        if (count > maxItems) count = maxItems;
+        
+        for (uint32_t i = 0; i < count; i++) {
+            items[i] = _items[(tail + i) & (Capacity - 1)];
+        }
+        __atomic_store_n(&_tail, tail + count, __ATOMIC_RELEASE);
+        return (uint16_t)count;
+    }
+    
+    /**
+     * Get the number of items waiting (approximate while the producer runs)
+     * @return Item count
+     */
+    uint16_t size() const {
+        return (uint16_t)(__atomic_load_n(&_head, __ATOMIC_ACQUIRE) -
+                          __atomic_load_n(&_tail, __ATOMIC_ACQUIRE));
+    }
+    
+    /**
+     * Get the number of items rejected because the ring was full
+     * @return Dropped item count
+     */
+    uint32_t dropped() const {
+        return __atomic_load_n(&_dropped, __ATOMIC_RELAXED);
+    }
+    
+    /**
+     * Get the ring capacity
+     * @return Maximum number of items
+     */
+    static uint16_t capacity() {
+        return Capacity;
+    }
+};
+
+#endif // BQ25723_RING_HPP
@@ -0,0 +1,193 @@
+/**
+ * BQ25723Sampler.hpp
+ *
+ * Background telemetry sampler for the BQ25723 on the ESP32
+ * A pinned FreeRTOS task reads status and ADC registers in one burst at a
+ * fixed rate and stores timestamped samples in a preallocated ring buffer.
+ * Consumers drain samples in batches at their own pace.
+ */
+
+#ifndef BQ25723_SAMPLER_HPP
+#define BQ25723_SAMPLER_HPP
+
+#if defined(ESP32)
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "BQ25723.hpp"
+#include "BQ25723Ring.hpp"
+
+// Sampler task stack size in bytes
+#ifndef BQ25723_SAMPLER_STACK_SIZE
+#define BQ25723_SAMPLER_STACK_SIZE 3072
+#endif
+
+// One telemetry sample
+struct BQ25723Sample {
+    uint32_t timestampUs;   // micros() when the burst read completed
+    BQ25723Telemetry telemetry;
+};
+
+// Called from the sampler task with each sample before it is queued
+typedef void (*BQ25723SampleCallback)(const BQ25723Sample& sample, void* arg);
+
+/**
+ * Periodic telemetry sampler
+ * Build with BQ25723_THREAD_SAFE=1 if other tasks use the driver while the
+ * sampler runs.
+ * @tparam Capacity Ring buffer size in samples (power of two)
+ */
+template <uint16_t Capacity = 64>
+class BQ25723Sampler {
+private:
+    BQ25723& _charger;
+    BQ25723Ring<BQ25723Sample, Capacity> _ring;
+    uint32_t _periodMs;
+    uint32_t _errors;
+    BQ25723SampleCallback _onSample;
+    void* _onSampleArg;
+    TaskHandle_t _task;
+    StaticTask_t _taskBuffer;
+    StackType_t _stack[BQ25723_SAMPLER_STACK_SIZE];
+    
+    static void samplerTask(void* param) {
+        BQ25723Sampler* self = static_cast<BQ25723Sampler*>(param);
+        TickType_t lastWake = xTaskGetTickCount();
+        
+        for (;;) {
+            self->sampleOnce();
+            
+            TickType_t period = pdMS_TO_TICKS(__atomic_load_n(&self->_periodMs, __ATOMIC_RELAXED));
+            vTaskDelayUntil(&lastWake, period ? period : 1);
+        }
+    }
+    
+public:
+    /**
+     * Constructor
+     * @param charger Initialized driver to sample
+     */
+    explicit BQ25723Sampler(BQ25723& charger)
+        : _charger(charger), _periodMs(100), _errors(0),
+          _onSample(nullptr), _onSampleArg(nullptr), _task(nullptr) {}
+    
+    ~BQ25723Sampler() {
+        end();
+    }
+    
+    /**
+     * Start sampling
+     * @param periodMs Sampling period in milliseconds
+     * @param continuousAdc true to switch the ADC to continuous conversion of
+     *                      all channels first
+     * @param priority FreeRTOS priority of the sampler task
+     * @param core Core to pin the sampler task to
+     * @return true if the sampler task is running
+     */
+    bool begin(uint32_t periodMs, bool continuousAdc = true,
+               UBaseType_t priority = 5, BaseType_t core = 1) {
+        if (_task) return true;
+        
+        _periodMs = periodMs;
+        if (continuousAdc && !_charger.configureAdc(BQ25723_ADC_CONTINUOUS)) {
+            return false;
+        }
+        
+        _task = xTaskCreateStaticPinnedToCore(samplerTask, "bq25723_smp", BQ25723_SAMPLER_STACK_SIZE,
+                                              this, priority, _stack, &_taskBuffer, core);
+        return _task != nullptr;
+    }
+    
+    /**
+     * Stop sampling; samples already in the ring remain available
+     */
+    void end() {
+        if (_task) {
+            vTaskDelete(_task);
+            _task = nullptr;
+        }
+    }
+    
+    /**
+     * Change the sampling period; takes effect after the current period
+     * @param periodMs Sampling period in milliseconds
+     */
+    void setPeriod(uint32_t periodMs) {
+        __atomic_store_n(&_periodMs, periodMs, __ATOMIC_RELAXED);
+    }
+    
+    /**
+     * Set a callback run on the sampler task for every sample
+     * Use it for per-sample processing such as BQ25723Stats; keep it short,
+     * it delays the next burst read. Set it before begin().
+     * @param callback Function to call, or nullptr to remove
+     * @param arg Argument passed to the callback
+     */
+    void onSample(BQ25723SampleCallback callback, void* arg = nullptr) {
+        _onSample = callback;
+        _onSampleArg = arg;
+    }
+    
+    /**
+     * Take one sample immediately (called by the sampler task)
+     * @return true if the sample was read and stored
+     */
+    bool sampleOnce() {
+        BQ25723Sample sample;
+        if (!_charger.readTelemetry(&sample.telemetry)) {
+            __atomic_fetch_add(&_errors, 1, __ATOMIC_RELAXED);
+            return false;
+        }
+        sample.timestampUs = micros();
+        if (_onSample) _onSample(sample, _onSampleArg);
+        return _ring.push(sample);
+    }
+    
+    /**
+     * Remove up to maxSamples of the oldest samples
+     * @param samples Array to store the samples
+     * @param maxSamples Capacity of the array
+     * @return Number of samples removed
+     */
+    uint16_t drain(BQ25723Sample* samples, uint16_t maxSamples) {
+        return _ring.drain(samples, maxSamples);
+    }
+    
+    /**
+     * Remove the oldest sample
+     * @param sample Pointer to store the sample
+     * @return true if a sample was available
+     */
+    bool pop(BQ25723Sample* sample) {
+        return _ring.pop(sample);
+    }
+    
+    /**
+     * Get the number of samples waiting
+     * @return Sample count
+     */
+    uint16_t available() const {
+        return _ring.size();
+    }
+    
+    /**
+     * Get the number of samples lost because the ring was full
+     * @return Dropped sample count
+     */
+    uint32_t dropped() const {
+        return _ring.dropped();
+    }
+    
+    /**
+     * Get the number of failed burst reads
+     * @return Error count
+     */
+    uint32_t errors() const {
+        return __atomic_load_n(&_errors, __ATOMIC_RELAXED);
+    }
+};
+
+#endif // ESP32
+
+#endif // BQ25723_SAMPLER_HPP
@@ -0,0 +1,288 @@
+/**
+ * BQ25723Scheduler.hpp
+ *
+ * Power-state aware polling for the BQ25723
+ * Each poll reads status and ADC results in one burst and decodes the
+ * power state from CHARGER_STATUS. The state selects the next polling
+ * period and the ADC mode: continuous while external power is available,
+ * one-shot on battery, where a conversion is started only for each poll.
+ *
+ * update() never blocks. Between polls, sleep until getNextWakeMs() (on the
+ * ESP32, lightSleep() does this with a timer wake-up).
+ */
+
+#ifndef BQ25723_SCHEDULER_HPP
+#define BQ25723_SCHEDULER_HPP
+
+#include <Arduino.h>
+#include "BQ25723.hpp"
+
+#if defined(ESP32)
+#include <esp_sleep.h>
+#endif
+
+// Default polling periods in milliseconds
+#ifndef BQ25723_SCHEDULER_FAULT_MS
+#define BQ25723_SCHEDULER_FAULT_MS 250
+#endif
+#ifndef BQ25723_SCHEDULER_CHARGING_MS
+#define BQ25723_SCHEDULER_CHARGING_MS 1000
+#endif
+#ifndef BQ25723_SCHEDULER_ADAPTER_MS
+#define BQ25723_SCHEDULER_ADAPTER_MS 5000
+#endif
+#ifndef BQ25723_SCHEDULER_BATTERY_MS
+#define BQ25723_SCHEDULER_BATTERY_MS 60000
+#endif
+
+// Wait for a one-shot conversion before checking that it has finished
+#ifndef BQ25723_SCHEDULER_CONVERSION_MS
+#define BQ25723_SCHEDULER_CONVERSION_MS 30
+#endif
+
+// Fault bits that select BQ25723_POWER_FAULT (CONV_OFF only reports the
+// converter state)
+#define BQ25723_SCHEDULER_FAULT_MASK (0xFF & ~BQ25723_FAULT_CONV_OFF)
+
+// Power state decoded from CHARGER_STATUS
+enum BQ25723PowerState : uint8_t {
+    BQ25723_POWER_FAULT    = 0,   // A fault bit is set
+    BQ25723_POWER_CHARGING = 1,   // Adapter present, fast or pre-charge
+    BQ25723_POWER_ADAPTER  = 2,   // Adapter present, not charging
+    BQ25723_POWER_BATTERY  = 3,   // Adapter absent
+    BQ25723_POWER_UNKNOWN  = 4    // Before the first poll
+};
+
+#define BQ25723_POWER_STATE_COUNT 4
+
+typedef void (*BQ25723PowerStateCallback)(BQ25723PowerState from, BQ25723PowerState to, void* arg);
+
+class BQ25723Scheduler {
+private:
+    BQ25723& _charger;
+    uint32_t _periodMs[BQ25723_POWER_STATE_COUNT];
+    uint8_t _adcMode[BQ25723_POWER_STATE_COUNT];   // BQ25723AdcMode per state
+    uint8_t _channels;
+    BQ25723PowerState _state;
+    bool _converting;              // One-shot conversion started, not yet read
+    uint32_t _nextWakeMs;
+    uint32_t _errors;
+    BQ25723Telemetry _telemetry;
+    BQ25723PowerStateCallback _onChange;
+    void* _onChangeArg;
+    
+    uint32_t period() const {
+        return _periodMs[_state < BQ25723_POWER_STATE_COUNT ? _state : BQ25723_POWER_FAULT];
+    }
+    
+    BQ25723AdcMode adcMode(BQ25723PowerState state) const {
+        return (BQ25723AdcMode)_adcMode[state < BQ25723_POWER_STATE_COUNT ? state : BQ25723_POWER_FAULT];
+    }
+    
+    bool enterState(BQ25723PowerState state) {
+        if (state == _state) return true;
+        if (_state == BQ25723_POWER_UNKNOWN || adcMode(state) != adcMode(_state)) {
+            // Stay in the old state until its ADC mode is replaced
+            if (!_charger.configureAdc(adcMode(state), _channels)) return false;
+        }
+        BQ25723PowerState from = _state;
+        _state = state;
+        if (_onChange) _onChange(from, state, _onChangeArg);
+        return true;
+    }
+    
+public:
+    /**
+     * Constructor
+     * @param charger Initialized driver
+     */
+    explicit BQ25723Scheduler(BQ25723& charger)
+        : _charger(charger), _channels(BQ25723_ADC_CH_ALL), _state(BQ25723_POWER_UNKNOWN),
+          _converting(false), _nextWakeMs(0), _errors(0), _onChange(nullptr), _onChangeArg(nullptr) {
+        _periodMs[BQ25723_POWER_FAULT] = BQ25723_SCHEDULER_FAULT_MS;
+        _periodMs[BQ25723_POWER_CHARGING] = BQ25723_SCHEDULER_CHARGING_MS;
+        _periodMs[BQ25723_POWER_ADAPTER] = BQ25723_SCHEDULER_ADAPTER_MS;
+        _periodMs[BQ25723_POWER_BATTERY] = BQ25723_SCHEDULER_BATTERY_MS;
+        _adcMode[BQ25723_POWER_FAULT] = BQ25723_ADC_CONTINUOUS;
+        _adcMode[BQ25723_POWER_CHARGING] = BQ25723_ADC_CONTINUOUS;
+        _adcMode[BQ25723_POWER_ADAPTER] = BQ25723_ADC_CONTINUOUS;
+        _adcMode[BQ25723_POWER_BATTERY] = BQ25723_ADC_ONE_SHOT;
+        memset(&_telemetry, 0, sizeof(_telemetry));
+    }
+    
+    /**
+     * Poll once immediately to establish the state and ADC mode
+     * @param channels BQ25723_ADC_CH_* bits to convert
+     * @return true if the first poll succeeded
+     */
+    bool begin(uint8_t channels = BQ25723_ADC_CH_ALL) {
+        _channels = channels;
+        _state = BQ25723_POWER_UNKNOWN;
+        _converting = false;
+        _nextWakeMs = millis();
+        return update();
+    }
+    
+    /**
+     * Set the polling period of a state
+     * Takes effect from the next poll.
+     * @param state Power state
+     * @param periodMs Interval between polls in milliseconds
+     */
+    void setPeriod(BQ25723PowerState state, uint32_t periodMs) {
+        if (state < BQ25723_POWER_STATE_COUNT) _periodMs[state] = periodMs;
+    }
+    
+    /**
+     * Set the ADC mode used in a state
+     * @param state Power state
+     * @param mode Continuous, or one-shot with a conversion per poll
+     * @return true if set, false if the state is invalid or the ADC of the
+     *         current state could not be reconfigured (the old mode is kept)
+     */
+    bool setAdcMode(BQ25723PowerState state, BQ25723AdcMode mode) {
+        if (state >= BQ25723_POWER_STATE_COUNT) return false;
+        if (state == _state && mode != adcMode(state)) {
+            if (!_charger.configureAdc(mode, _channels)) return false;
+            _converting = false;
+        }
+        _adcMode[state] = mode;
+        return true;
+    }
+    
+    /**
+     * Poll if the wake deadline has passed; call from loop()
+     * In one-shot mode a poll first starts a conversion and returns; the
+     * results are read BQ25723_SCHEDULER_CONVERSION_MS later. If the ADC
+     * cannot be set up for a new state the old state is kept and the change
+     * is retried at the next poll.
+     * @return true if new telemetry was read and its state entered
+     */
+    bool update() {
+        uint32_t now = millis();
+        if ((int32_t)(now - _nextWakeMs) < 0) return false;
+        
+        if (_state != BQ25723_POWER_UNKNOWN && adcMode(_state) == BQ25723_ADC_ONE_SHOT) {
+            if (!_converting) {
+                if (!_charger.startAdcConversion()) {
+                    _errors++;
+                    _nextWakeMs = now + period();
+                    return false;
+                }
+                _converting = true;
+                _nextWakeMs = now + BQ25723_SCHEDULER_CONVERSION_MS;
+                return false;
+            }
+            bool done = false;
+            if (!_charger.isAdcConversionDone(&done)) {
+                _errors++;   // Not known to be ready; check again
+                done = false;
+            }
+            if (!done) {
+                _nextWakeMs = now + BQ25723_SCHEDULER_CONVERSION_MS;
+                return false;
+            }
+        }
+        _converting = false;
+        
+        BQ25723Telemetry telemetry;
+        if (!_charger.readTelemetry(&telemetry)) {
+            _errors++;
+            _nextWakeMs = now + period();
+            return false;
+        }
+        _telemetry = telemetry;
+        bool entered = enterState(decodeState(telemetry.chargerStatus));
+        if (!entered) _errors++;
+        _nextWakeMs = now + period();
+        return entered;
+    }
+    
+    /**
+     * Poll on the next update() call (e.g. after a status interrupt)
+     */
+    void wake() {
+        _nextWakeMs = millis();
+        _converting = false;
+    }
+    
+    /**
+     * Get the millis() time of the next poll
+     * @return Deadline in milliseconds
+     */
+    uint32_t getNextWakeMs() const {
+        return _nextWakeMs;
+    }
+    
+    /**
+     * Get the time left until the next poll
+     * @return Milliseconds, 0 if the poll is due
+     */
+    uint32_t getMsUntilWake() const {
+        int32_t left = (int32_t)(_nextWakeMs - millis());
+        return left > 0 ? (uint32_t)left : 0;
+    }
+
+#if defined(ESP32)
+    /**
+     * Enter light sleep until the next poll is due
+     * Other wake-up sources configured by the application stay active.
+     * @return true if the chip slept
+     */
+    bool lightSleep() {
+        uint32_t ms = getMsUntilWake();
+        if (!ms) return false;
+        esp_sleep_enable_timer_wakeup((uint64_t)ms * 1000);
+        return esp_light_sleep_start() == ESP_OK;
+    }
+#endif
+
+    /**
+     * Set a callback for power state changes
+     * @param callback Function to call, or nullptr to remove
+     * @param arg Argument passed to the callback
+     */
+    void onStateChange(BQ25723PowerStateCallback callback, void* arg = nullptr) {
+        _onChange = callback;
+        _onChangeArg = arg;
+    }
+    
+    /**
+     * Get the power state decoded by the last poll
+     * @return Power state (BQ25723_POWER_UNKNOWN before the first poll)
+     */
+    BQ25723PowerState getState() const {
+        return _state;
+    }
+    
+    /**
+     * Get the telemetry read by the last poll
+     * @return Telemetry (zero before the first poll)
+     */
+    const BQ25723Telemetry& getTelemetry() const {
+        return _telemetry;
+    }
+    
+    /**
+     * Get the number of failed polls
+     * @return Error count
+     */
+    uint32_t getErrorCount() const {
+        return _errors;
+    }
+    
+    /**
+     * Decode the power state from CHARGER_STATUS
+     * @param chargerStatus Register value
+     * @return Power state
+     */
+    static BQ25723PowerState decodeState(uint16_t chargerStatus) {
+        using namespace BQ25723Fields;
+        if (FAULTS::get(chargerStatus) & BQ25723_SCHEDULER_FAULT_MASK) return BQ25723_POWER_FAULT;
+        if (!AC_STAT::get(chargerStatus)) return BQ25723_POWER_BATTERY;
+        if (IN_FCHRG::get(chargerStatus) || IN_PCHRG::get(chargerStatus)) return BQ25723_POWER_CHARGING;
+        return BQ25723_POWER_ADAPTER;
+    }
+};
+
+#endif // BQ25723_SCHEDULER_HPP
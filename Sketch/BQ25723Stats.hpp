@@ -0,0 +1,310 @@
+/**
+ * BQ25723Stats.hpp
+ *
+ * Incremental statistics over BQ25723 ADC samples
+ * Each sample updates, per channel (IBAT, VBAT, VSYS), an integer EMA, a
+ * windowed mean and a windowed min/max, and integrates IBAT into a charge
+ * count. Every update is constant time (min/max amortized) with storage
+ * fixed by the window size, so consumers read ready-made aggregates instead
+ * of rescanning samples.
+ *
+ * On the ESP32, attach() feeds the stage from BQ25723Sampler's task; the
+ * aggregates are published through a sequence lock, so readers on other
+ * tasks or cores never block the sampler.
+ */
+
+#ifndef BQ25723_STATS_HPP
+#define BQ25723_STATS_HPP
+
+#include <Arduino.h>
+#include "BQ25723.hpp"
+#include "BQ25723Sampler.hpp"
+
+// Default EMA smoothing: alpha = 1 / 2^shift
+#ifndef BQ25723_STATS_EMA_SHIFT
+#define BQ25723_STATS_EMA_SHIFT 3
+#endif
+
+// Sample gaps longer than this are not integrated into the charge count
+#ifndef BQ25723_STATS_MAX_GAP_US
+#define BQ25723_STATS_MAX_GAP_US 10000000UL
+#endif
+
+// Fractional bits of the EMA accumulator
+#define BQ25723_STATS_EMA_FRAC_BITS 8
+
+// Channels tracked per sample
+enum BQ25723StatChannelId : uint8_t {
+    BQ25723_STAT_IBAT = 0,   // ICHG - IDCHG in mA, positive while charging
+    BQ25723_STAT_VBAT = 1,   // mV
+    BQ25723_STAT_VSYS = 2    // mV
+};
+
+#define BQ25723_STAT_CHANNEL_COUNT 3
+
+// Aggregates of one channel
+struct BQ25723StatChannel {
+    int32_t ema;    // Exponential moving average
+    int32_t mean;   // Mean over the window (truncated)
+    int32_t min;    // Minimum over the window
+    int32_t max;    // Maximum over the window
+};
+
+// Aggregates published after each sample
+struct BQ25723StatsSnapshot {
+    BQ25723StatChannel channel[BQ25723_STAT_CHANNEL_COUNT];   // By BQ25723StatChannelId
+    int32_t charge_uAh;     // Integrated IBAT since the last resetCharge()
+    uint32_t timestampUs;   // Timestamp of the latest sample
+    uint32_t samples;       // Samples added since reset()
+    uint16_t window;        // Samples currently in the window
+};
+
+/**
+ * Running statistics of one value stream
+ * The window is a ring of the latest samples with a running sum; min and
+ * max come from monotonic queues of sample indices, so each push costs
+ * amortized O(1) comparisons.
+ * @tparam Window Window size in samples (power of two, at most 256)
+ */
+template <uint16_t Window>
+class BQ25723RunningStat {
+    static_assert(Window >= 2 && Window <= 256 && (Window & (Window - 1)) == 0,
+                  "Window must be a power of two no larger than 256");
+                  
+private:
+    static const uint16_t MASK = Window - 1;
+    
+    int32_t _values[Window];
+    uint16_t _minQueue[Window];   // Indices with increasing values, oldest first
+    uint16_t _maxQueue[Window];   // Indices with decreasing values, oldest first
+    uint16_t _minHead, _minTail;
+    uint16_t _maxHead, _maxTail;
+    uint16_t _next;               // Index of the next sample (wraps)
+    uint16_t _count;              // Samples in the window
+    int32_t _sum;
+    int32_t _ema;                 // Fixed point, BQ25723_STATS_EMA_FRAC_BITS
+    
+    int32_t valueAt(uint16_t index) const {
+        return _values[index & MASK];
+    }
+    
+public:
+    BQ25723RunningStat() {
+        reset();
+    }
+    
+    /**
+     * Discard all samples
+     */
+    void reset() {
+        _minHead = _minTail = _maxHead = _maxTail = 0;
+        _next = 0;
+        _count = 0;
+        _sum = 0;
+        _ema = 0;
+    }
+    
+    /**
+     * Add a sample, replacing the oldest one once the window is full
+     * @param value Sample value
+     * @param emaShift EMA smoothing, alpha = 1 / 2^emaShift
+     */
+    void push(int32_t value, uint8_t emaShift) {
+        uint16_t index = _next++;
+        if (_count == Window) {
+            uint16_t expired = (uint16_t)(index - Window);
+            _sum -= valueAt(expired);
+            if (_minQueue[_minHead & MASK] == expired) _minHead++;
+            if (_maxQueue[_maxHead & MASK] == expired) _maxHead++;
+        } else {
+            _count++;
+        }
+        _values[index & MASK] = value;
+        _sum += value;
+        
+        while (_minTail != _minHead && valueAt(_minQueue[(uint16_t)(_minTail - 1) & MASK]) >= value) _minTail--;
+        _minQueue[_minTail++ & MASK] = index;
+        while (_maxTail != _maxHead && valueAt(_maxQueue[(uint16_t)(_maxTail - 1) & MASK]) <= value) _maxTail--;
+        _maxQueue[_maxTail++ & MASK] = index;
+        
+        int32_t scaled = value * (1 << BQ25723_STATS_EMA_FRAC_BITS);
+        if (_count == 1) {
+            _ema = scaled;   // Seed with the first sample
+        } else {
+            _ema += (scaled - _ema) / (1 << emaShift);
+        }
+    }
+    
+    /**
+     * Get the aggregates
+     * @param channel Pointer to store the aggregates (zero before the first sample)
+     */
+    void get(BQ25723StatChannel* channel) const {
+        if (!_count) {
+            memset(channel, 0, sizeof(*channel));
+            return;
+        }
+        channel->ema = (_ema + (1 << (BQ25723_STATS_EMA_FRAC_BITS - 1))) >> BQ25723_STATS_EMA_FRAC_BITS;
+        channel->mean = _sum / (int32_t)_count;
+        channel->min = valueAt(_minQueue[_minHead & MASK]);
+        channel->max = valueAt(_maxQueue[_maxHead & MASK]);
+    }
+    
+    /**
+     * Get the number of samples in the window
+     * @return Count, at most Window
+     */
+    uint16_t count() const {
+        return _count;
+    }
+};
+
+/**
+ * Statistics stage for ADC samples
+ * add() runs on one task (the sampler's when attached); snapshot() may be
+ * called from any task.
+ * @tparam Window Window size in samples for mean and min/max (power of two, at most 256)
+ */
+template <uint16_t Window = 32>
+class BQ25723Stats {
+private:
+    BQ25723RunningStat<Window> _channels[BQ25723_STAT_CHANNEL_COUNT];
+    BQ25723SeqLock<BQ25723StatsSnapshot> _published;
+    int64_t _charge_mAus;       // Integrated IBAT in mA x us
+    int32_t _lastIbat;
+    uint32_t _lastUs;
+    uint32_t _samples;
+    uint8_t _emaShift;
+    bool _resetCharge;          // Set by resetCharge(), applied by add()
+
+#if defined(ESP32)
+    static void handleSample(const BQ25723Sample& sample, void* arg) {
+        static_cast<BQ25723Stats*>(arg)->add(sample.telemetry.adc, sample.timestampUs);
+    }
+#endif
+
+public:
+    BQ25723Stats() : _emaShift(BQ25723_STATS_EMA_SHIFT) {
+        reset();
+    }
+    
+    /**
+     * Discard all samples and zero the charge count
+     * Not safe while add() may run; use resetCharge() then.
+     */
+    void reset() {
+        for (uint8_t i = 0; i < BQ25723_STAT_CHANNEL_COUNT; i++) _channels[i].reset();
+        _charge_mAus = 0;
+        _lastIbat = 0;
+        _lastUs = 0;
+        _samples = 0;
+        _resetCharge = false;
+        BQ25723StatsSnapshot empty;
+        memset(&empty, 0, sizeof(empty));
+        _published.publish(empty);
+    }
+    
+    /**
+     * Set the EMA smoothing
+     * @param shift alpha = 1 / 2^shift (0-15, 0 tracks the latest sample)
+     */
+    void setEmaShift(uint8_t shift) {
+        __atomic_store_n(&_emaShift, shift > 15 ? 15 : shift, __ATOMIC_RELAXED);
+    }
+    
+    /**
+     * Zero the charge count at the next sample (e.g. at full charge)
+     * Safe to call from any task.
+     */
+    void resetCharge() {
+        __atomic_store_n(&_resetCharge, true, __ATOMIC_RELAXED);
+    }
+    
+    /**
+     * Add one ADC reading and publish the updated aggregates
+     * The charge count integrates IBAT with the trapezoidal rule between
+     * consecutive samples; gaps over BQ25723_STATS_MAX_GAP_US are skipped.
+     * @param reading ADC results
+     * @param timestampUs micros() when the reading was taken
+     */
+    void add(const BQ25723AdcReading& reading, uint32_t timestampUs) {
+        uint8_t shift = __atomic_load_n(&_emaShift, __ATOMIC_RELAXED);
+        int32_t ibat = (int32_t)reading.ichg_mA - (int32_t)reading.idchg_mA;
+        
+        if (__atomic_exchange_n(&_resetCharge, false, __ATOMIC_RELAXED)) _charge_mAus = 0;
+        if (_samples) {
+            uint32_t dt = timestampUs - _lastUs;
+            if (dt <= BQ25723_STATS_MAX_GAP_US) {
+                _charge_mAus += (int64_t)(ibat + _lastIbat) * dt / 2;
+            }
+        }
+        _lastIbat = ibat;
+        _lastUs = timestampUs;
+        _samples++;
+        
+        _channels[BQ25723_STAT_IBAT].push(ibat, shift);
+        _channels[BQ25723_STAT_VBAT].push(reading.vbat_mV, shift);
+        _channels[BQ25723_STAT_VSYS].push(reading.vsys_mV, shift);
+        
+        BQ25723StatsSnapshot snapshot;
+        for (uint8_t i = 0; i < BQ25723_STAT_CHANNEL_COUNT; i++) _channels[i].get(&snapshot.channel[i]);
+        snapshot.charge_uAh = (int32_t)(_charge_mAus / 3600000LL);   // 1 uAh = 3.6e6 mA x us
+        snapshot.timestampUs = timestampUs;
+        snapshot.samples = _samples;
+        snapshot.window = _channels[0].count();
+        _published.publish(snapshot);
+    }
+    
+    /**
+     * Add a telemetry snapshot
+     * @param telemetry Burst read results
+     * @param timestampUs micros() when the telemetry was read
+     */
+    void add(const BQ25723Telemetry& telemetry, uint32_t timestampUs) {
+        add(telemetry.adc, timestampUs);
+    }
+
+#if defined(ESP32)
+    /**
+     * Feed every sample taken by a sampler into this stage
+     * Takes over the sampler's onSample() callback; call before sampler.begin().
+     * @param sampler Sampler to take samples from
+     */
+    template <uint16_t Capacity>
+    void attach(BQ25723Sampler<Capacity>& sampler) {
+        sampler.onSample(handleSample, this);
+    }
+#endif
+
+    /**
+     * Copy the latest aggregates without blocking the writer
+     * @param snapshot Pointer to store the aggregates
+     * @return Sequence number (changes with every sample and reset())
+     */
+    uint32_t snapshot(BQ25723StatsSnapshot* snapshot) const {
+        return _published.read(snapshot);
+    }
+    
+    /**
+     * Copy the latest aggregates of one channel
+     * @param id Channel
+     * @param channel Pointer to store the aggregates
+     */
+    void getChannel(BQ25723StatChannelId id, BQ25723StatChannel* channel) const {
+        BQ25723StatsSnapshot copy;
+        _published.read(&copy);
+        *channel = copy.channel[id < BQ25723_STAT_CHANNEL_COUNT ? id : 0];
+    }
+    
+    /**
+     * Get the integrated battery charge
+     * @return Charge in uAh since the last resetCharge(), positive when charged
+     */
+    int32_t getCharge_uAh() const {
+        BQ25723StatsSnapshot copy;
+        _published.read(&copy);
+        return copy.charge_uAh;
+    }
+};
+
+#endif // BQ25723_STATS_HPP
@@ -0,0 +1,171 @@
+/**
+ * BQ25723TransportIdf.hpp
+ *
+ * BQ25723 transport over the ESP-IDF i2c_master driver (ESP-IDF 5.x)
+ * Transfers run on the controller's hardware command list straight from the
+ * driver's word buffers, without passing through the Arduino Wire buffer and
+ * its size limit. Define BQ25723_I2C_BUFFER_SIZE before including
+ * BQ25723.hpp to allow longer bursts.
+ *
+ * The i2c_master driver cannot share a port with the legacy driver used by
+ * Wire; give this transport a port of its own or attach to an existing
+ * i2c_master bus handle.
+ */
+
+#ifndef BQ25723_TRANSPORT_IDF_HPP
+#define BQ25723_TRANSPORT_IDF_HPP
+
+#if defined(ESP32) && defined(__has_include)
+#if __has_include(<driver/i2c_master.h>)
+#define BQ25723_HAS_IDF_TRANSPORT 1
+#endif
+#endif
+
+#if BQ25723_HAS_IDF_TRANSPORT
+
+#include <Arduino.h>
+#include <driver/i2c_master.h>
+#include <esp_idf_version.h>
+#include "BQ25723.hpp"
+
+// Per-transaction timeout in milliseconds
+#ifndef BQ25723_IDF_TIMEOUT_MS
+#define BQ25723_IDF_TIMEOUT_MS 20
+#endif
+
+class BQ25723IdfTransport : public BQ25723Transport {
+private:
+    i2c_port_num_t _port;
+    i2c_master_bus_handle_t _bus;
+    i2c_master_dev_handle_t _device;
+    uint8_t _deviceAddress;     // Address _device was created for
+    uint32_t _clockHz;
+    bool _ownsBus;
+    
+    static uint8_t toStatus(esp_err_t err) {
+        switch (err) {
+            case ESP_OK:            return BQ25723_BUS_OK;
+            case ESP_ERR_TIMEOUT:   return BQ25723_BUS_TIMEOUT;
+            case ESP_ERR_NOT_FOUND: return BQ25723_BUS_NACK_ADDRESS;
+            case ESP_ERR_INVALID_SIZE:
+            case ESP_ERR_INVALID_ARG: return BQ25723_BUS_DATA_TOO_LONG;
+            default:                return BQ25723_BUS_ERROR;
+        }
+    }
+    
+    void releaseDevice() {
+        if (_device) {
+            i2c_master_bus_rm_device(_device);
+            _device = nullptr;
+        }
+    }
+    
+    // Device handles carry the address and clock, so recreate on change
+    bool selectDevice(uint8_t address) {
+        if (_device && address == _deviceAddress) return true;
+        if (!_bus) return false;
+        releaseDevice();
+        
+        i2c_device_config_t config = {};
+        config.dev_addr_length = I2C_ADDR_BIT_LEN_7;
+        config.device_address = address;
+        config.scl_speed_hz = _clockHz;
+        if (i2c_master_bus_add_device(_bus, &config, &_device) != ESP_OK) {
+            _device = nullptr;
+            return false;
+        }
+        _deviceAddress = address;
+        return true;
+    }
+    
+public:
+    /**
+     * Constructor for a bus created by begin()
+     * @param port I2C controller to use
+     */
+    explicit BQ25723IdfTransport(i2c_port_num_t port = I2C_NUM_1)
+        : _port(port), _bus(nullptr), _device(nullptr), _deviceAddress(0),
+          _clockHz(100000), _ownsBus(true) {}
+    
+    /**
+     * Constructor for an existing i2c_master bus (begin() pins are ignored)
+     * @param bus Bus handle from i2c_new_master_bus()
+     */
+    explicit BQ25723IdfTransport(i2c_master_bus_handle_t bus)
+        : _port(-1), _bus(bus), _device(nullptr), _deviceAddress(0),
+          _clockHz(100000), _ownsBus(false) {}
+    
+    ~BQ25723IdfTransport() {
+        releaseDevice();
+        if (_ownsBus && _bus) i2c_del_master_bus(_bus);
+    }
+    
+    bool begin(int sdaPin, int sclPin) override {
+        if (_bus) return true;
+        
+        i2c_master_bus_config_t config = {};
+        config.i2c_port = _port;
+        config.sda_io_num = (gpio_num_t)(sdaPin >= 0 ? sdaPin : SDA);
+        config.scl_io_num = (gpio_num_t)(sclPin >= 0 ? sclPin : SCL);
+        config.clk_source = I2C_CLK_SRC_DEFAULT;
+        config.glitch_ignore_cnt = 7;
+        config.flags.enable_internal_pullup = true;
+        if (i2c_new_master_bus(&config, &_bus) != ESP_OK) {
+            _bus = nullptr;
+            return false;
+        }
+        return true;
+    }
+    
+    void setClock(uint32_t hz) override {
+        if (hz == _clockHz) return;
+        _clockHz = hz;
+        releaseDevice();
+    }
+    
+    uint8_t probe(uint8_t address) override {
+        if (!_bus) return BQ25723_BUS_ERROR;
+        return toStatus(i2c_master_probe(_bus, address, BQ25723_IDF_TIMEOUT_MS));
+    }
+    
+    uint8_t read(uint8_t address, uint8_t regAddr, uint8_t* data, uint8_t length) override {
+        if (!selectDevice(address)) return BQ25723_BUS_ERROR;
+        return toStatus(i2c_master_transmit_receive(_device, &regAddr, 1, data, length,
+                                                    BQ25723_IDF_TIMEOUT_MS));
+    }
+    
+    uint8_t write(uint8_t address, uint8_t regAddr, const uint8_t* data, uint8_t length) override {
+        if (!selectDevice(address)) return BQ25723_BUS_ERROR;
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)
+        // Pointer byte and payload go out as one transaction from two buffers
+        i2c_master_transmit_multi_buffer_info_t buffers[2] = {
+            { &regAddr, 1 },
+            { const_cast<uint8_t*>(data), length }
+        };
+        return toStatus(i2c_master_multi_buffer_transmit(_device, buffers, 2, BQ25723_IDF_TIMEOUT_MS));
+#else
+        uint8_t frame[1 + 2 * BQ25723_BURST_MAX_WRITE_WORDS];
+        if (length > sizeof(frame) - 1) return BQ25723_BUS_DATA_TOO_LONG;
+        frame[0] = regAddr;
+        memcpy(&frame[1], data, length);
+        return toStatus(i2c_master_transmit(_device, frame, length + 1, BQ25723_IDF_TIMEOUT_MS));
+#endif
+    }
+    
+    // The driver clocks SCL until SDA is released and issues a STOP
+    bool recover() override {
+        return _bus && i2c_master_bus_reset(_bus) == ESP_OK;
+    }
+    
+    /**
+     * Get the bus handle (e.g. to attach other devices)
+     * @return Bus handle, or nullptr before begin()
+     */
+    i2c_master_bus_handle_t getBus() const {
+        return _bus;
+    }
+};
+
+#endif // BQ25723_HAS_IDF_TRANSPORT
+
+#endif // BQ25723_TRANSPORT_IDF_HPP
@@ -0,0 +1,212 @@
+/**
+ * BQ25723TransportMock.hpp
+ *
+ * In-memory BQ25723 transport for host builds and tests
+ * Models the register file with an auto-incrementing pointer, counts
+ * transactions and bytes, and can inject bus errors.
+ */
+
+#ifndef BQ25723_TRANSPORT_MOCK_HPP
+#define BQ25723_TRANSPORT_MOCK_HPP
+
+#include <Arduino.h>
+#include "BQ25723.hpp"
+
+class BQ25723MockTransport : public BQ25723Transport {
+private:
+    uint8_t _address;
+    uint8_t _memory[BQ25723_NAME_TABLE_SIZE];   // One byte per register address
+    uint32_t _clockHz;
+    uint32_t _transactions;
+    uint32_t _bytes;              // Address, pointer and data bytes on the bus
+    uint8_t _failSkip;            // Transactions to pass before failing
+    uint8_t _failCount;           // Transactions still to fail
+    uint8_t _failStatus;
+    uint8_t _stuckRecoveries;     // recover() calls still needed to free the bus
+    uint32_t _recoveries;
+    
+    uint8_t check(uint8_t address) {
+        _transactions++;
+        _bytes++;
+        if (_stuckRecoveries) {
+            return _failStatus;
+        }
+        if (_failCount) {
+            if (_failSkip) {
+                _failSkip--;
+            } else {
+                _failCount--;
+                return _failStatus;
+            }
+        }
+        return (address == _address) ? BQ25723_BUS_OK : BQ25723_BUS_NACK_ADDRESS;
+    }
+    
+public:
+    /**
+     * Constructor
+     * @param address I2C address the simulated device answers on
+     */
+    explicit BQ25723MockTransport(uint8_t address = BQ25723_I2C_ADDR_DEFAULT)
+        : _address(address), _clockHz(0), _transactions(0), _bytes(0),
+          _failSkip(0), _failCount(0), _failStatus(BQ25723_BUS_OK), _stuckRecoveries(0), _recoveries(0) {
+        memset(_memory, 0, sizeof(_memory));
+        _memory[BQ25723_REG_MANUFACTURER_ID] = 0x40;   // Texas Instruments
+        _memory[BQ25723_REG_DEVICE_ID] = 0x8A;
+    }
+    
+    bool begin(int, int) override {
+        return true;
+    }
+    
+    void setClock(uint32_t hz) override {
+        _clockHz = hz;
+    }
+    
+    uint8_t probe(uint8_t address) override {
+        return check(address);
+    }
+    
+    uint8_t read(uint8_t address, uint8_t regAddr, uint8_t* data, uint8_t length) override {
+        uint8_t status = check(address);
+        _bytes += 2;   // Pointer byte and repeated-start address
+        if (status != BQ25723_BUS_OK) return status;
+        
+        for (uint8_t i = 0; i < length; i++) {
+            data[i] = _memory[(regAddr + i) % sizeof(_memory)];
+        }
+        _bytes += length;
+        return BQ25723_BUS_OK;
+    }
+    
+    uint8_t write(uint8_t address, uint8_t regAddr, const uint8_t* data, uint8_t length) override {
+        uint8_t status = check(address);
+        _bytes++;
+        if (status != BQ25723_BUS_OK) return status;
+        
+        for (uint8_t i = 0; i < length; i++) {
+            _memory[(regAddr + i) % sizeof(_memory)] = data[i];
+        }
+        _bytes += length;
+        return BQ25723_BUS_OK;
+    }
+    
+    // Clears any pending injected failures, as a bus clear would; a stuck
+    // bus (see failUntilRecovered()) is freed only after enough calls
+    bool recover() override {
+        _recoveries++;
+        _failSkip = 0;
+        _failCount = 0;
+        if (_stuckRecoveries) _stuckRecoveries--;
+        return _stuckRecoveries == 0;
+    }
+    
+    /**
+     * Fail the next transactions
+     * @param count Number of transactions to fail
+     * @param status Status to return (default NACK on the address)
+     */
+    void failNext(uint8_t count, uint8_t status = BQ25723_BUS_NACK_ADDRESS) {
+        failAfter(0, count, status);
+    }
+    
+    /**
+     * Fail transactions after letting some through
+     * @param skip Number of transactions that succeed first
+     * @param count Number of transactions to fail
+     * @param status Status to return (default NACK on the address)
+     */
+    void failAfter(uint8_t skip, uint8_t count, uint8_t status = BQ25723_BUS_NACK_ADDRESS) {
+        _failSkip = skip;
+        _failCount = count;
+        _failStatus = status;
+    }
+    
+    /**
+     * Fail every transaction until recover() has been called some times
+     * @param recoveries Number of recover() calls that free the bus
+     * @param status Status to return meanwhile
+     */
+    void failUntilRecovered(uint8_t recoveries, uint8_t status = BQ25723_BUS_ERROR) {
+        _stuckRecoveries = recoveries;
+        _failStatus = status;
+    }
+    
+    /**
+     * Set a simulated register directly, bypassing the bus
+     * @param regAddr Register address
+     * @param value 16-bit value (stored LSB first)
+     */
+    void poke(uint8_t regAddr, uint16_t value) {
+        _memory[regAddr % sizeof(_memory)] = value & 0xFF;
+        _memory[(regAddr + 1) % sizeof(_memory)] = value >> 8;
+    }
+    
+    /**
+     * Get a simulated register directly, bypassing the bus
+     * @param regAddr Register address
+     * @return 16-bit value
+     */
+    uint16_t peek(uint8_t regAddr) const {
+        return _memory[regAddr % sizeof(_memory)] | (_memory[(regAddr + 1) % sizeof(_memory)] << 8);
+    }
+    
+    /**
+     * Get the I2C address the simulated device answers on
+     * @return 7-bit I2C address
+     */
+    uint8_t address() const {
+        return _address;
+    }
+    
+    /**
+     * Change the I2C address the simulated device answers on
+     * @param address 7-bit I2C address
+     */
+    void setAddress(uint8_t address) {
+        _address = address;
+    }
+    
+    /**
+     * Get the number of transactions seen, including failed ones
+     * @return Transaction count
+     */
+    uint32_t transactions() const {
+        return _transactions;
+    }
+    
+    /**
+     * Get the number of bytes that crossed the bus, including address bytes
+     * @return Byte count
+     */
+    uint32_t bytes() const {
+        return _bytes;
+    }
+    
+    /**
+     * Get the last clock rate requested
+     * @return Clock rate in Hz (0 before setClock())
+     */
+    uint32_t clock() const {
+        return _clockHz;
+    }
+    
+    /**
+     * Get the number of recover() calls
+     * @return Recovery count
+     */
+    uint32_t recoveries() const {
+        return _recoveries;
+    }
+    
+    /**
+     * Reset the transaction, byte and recovery counters
+     */
+    void resetCounters() {
+        _transactions = 0;
+        _bytes = 0;
+        _recoveries = 0;
+    }
+};
+
+#endif // BQ25723_TRANSPORT_MOCK_HPP
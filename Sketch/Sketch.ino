@@ -1,12 +1,27 @@
 #include <Wire.h>
 #include "BQ25723.hpp"
 
+// Set to 1 to print the simulated-bus benchmark (BQ25723Bench.hpp) at startup
+#define RUN_BENCHMARK 0
+
+#if RUN_BENCHMARK
+#include "BQ25723Bench.hpp"
+#endif
+
+// Set to 1 for the production start-up: no scan, no delays, and registers
+// rewritten only when they differ from bootConfig
+#define PRODUCTION_BOOT 0
+
 // Define the I2C pins for the ESP32 Wrover
 #define SDA_PIN 21
 #define SCL_PIN 22
 
 // Create an instance of the BQ25723 class
+#if PRODUCTION_BOOT
+BQ25723 charger(BQ25723_I2C_ADDR_DEFAULT, &Wire, BQ25723_I2C_SPEED_FAST); // Clock applied by beginFast()
+#else
 BQ25723 charger(BQ25723_I2C_ADDR_DEFAULT, &Wire, 100000); // Default I2C address 0x6B
+#endif
 
 void scanI2CBus() {
     Serial.println("Scanning I2C bus...");
@@ -31,61 +46,49 @@ void scanI2CBus() {
     }
 }
 
+#if PRODUCTION_BOOT
+// Configuration the charger should hold; fill from saveConfig() on a
+// known-good board (or BQ25723ConfigStore) and set validMask accordingly
+BQ25723Config bootConfig;
+
+void setup() {
+    Serial.begin(115200);
+    Wire.begin(SDA_PIN, SCL_PIN);
+
+    uint8_t written = 0;
+    if (!charger.beginFast(&bootConfig, &written)) {
+        Serial.println("BQ25723 not found or configuration failed.");
+    } else if (written) {
+        Serial.print("BQ25723 registers rewritten: ");
+        Serial.println(written);
+    }
+}
+#else
 void setup() {
     Serial.begin(115200);
     delay(1000); // Give Serial monitor time to open
 
+#if RUN_BENCHMARK
+    BQ25723Bench bench;
+    bench.runAll(Serial);
+#endif
+
     Wire.begin(SDA_PIN, SCL_PIN);
-    Wire.setClock(100000);
 
     scanI2CBus();
 
-    // Try initializing the charger
-    if (charger.begin(SDA_PIN, SCL_PIN)) {
+    // Try initializing the charger, moving to the fastest clock that works
+    if (charger.begin(SDA_PIN, SCL_PIN, BQ25723_I2C_SPEED_FAST_PLUS)) {
+        Serial.print("I2C clock: ");
+        Serial.print(charger.getI2cSpeed() / 1000);
+        Serial.println(" kHz");
         Serial.println("\nDumping BQ25723 Registers:");
-        uint8_t knownRegisters[] = {
-            BQ25723_REG_CHARGE_OPTION_0,
-            BQ25723_REG_CHARGE_CURRENT,
-            BQ25723_REG_CHARGE_VOLTAGE,
-            BQ25723_REG_OTG_VOLTAGE,
-            BQ25723_REG_OTG_CURRENT,
-            BQ25723_REG_INPUT_VOLTAGE,
-            BQ25723_REG_VSYS_MIN,
-            BQ25723_REG_IIN_HOST,
-            BQ25723_REG_CHARGER_STATUS,
-            BQ25723_REG_PROCHOT_STATUS,
-            BQ25723_REG_IIN_DPM,
-            BQ25723_REG_ADCVBUS_PSYS,
-            BQ25723_REG_ADCIBAT,
-            BQ25723_REG_ADCIINCMPIN,
-            BQ25723_REG_ADCVSYSVBAT,
-            BQ25723_REG_MANUFACTURER_ID,
-            BQ25723_REG_DEVICE_ID,
-            BQ25723_REG_CHARGE_OPTION_1,
-            BQ25723_REG_CHARGE_OPTION_2,
-            BQ25723_REG_CHARGE_OPTION_3,
-            BQ25723_REG_PROCHOT_OPTION_0,
-            BQ25723_REG_PROCHOT_OPTION_1,
-            BQ25723_REG_ADC_OPTION,
-            BQ25723_REG_CHARGE_OPTION_4,
-            BQ25723_REG_VMIN_ACT_PROT
-        };
-
-        for (uint8_t i = 0; i < sizeof(knownRegisters); i++) {
-            uint8_t reg = knownRegisters[i];
-            uint16_t value = charger.readRegister(reg);
-            Serial.print("0x");
-            if (reg < 0x10) Serial.print("0");
-            Serial.print(reg, HEX);
-            Serial.print(" (");
-            Serial.print(BQ25723::getRegisterName(reg));
-            Serial.print("): 0x");
-            Serial.println(value, HEX);
-        }
+        charger.dumpRegisters(Serial);
     } else {
         Serial.println("BQ25723 not found at expected I2C address (0x6B or 0x6A).");
     }
 }
+#endif
 
 void loop() {
     // Nothing to do here
@@ -0,0 +1,23 @@
+/**
+ * bench_host.cpp
+ *
+ * Host runner for the BQ25723 bus-efficiency benchmark
+ * Build and run from the repository root:
+ *
+ *   g++ -std=gnu++11 -O2 -Ibench/host -ISketch bench/bench_host.cpp -o bq25723_bench
+ *   ./bq25723_bench [iterations] > bench_output.txt
+ */
+
+#include <stdlib.h>
+#include "BQ25723Bench.hpp"
+
+TwoWire Wire;
+
+int main(int argc, char** argv) {
+    uint32_t iterations = (argc > 1) ? strtoul(argv[1], nullptr, 10) : BQ25723_BENCH_ITERATIONS;
+    
+    HostSerial out;
+    BQ25723Bench bench;
+    bench.runAll(out, iterations ? iterations : 1);
+    return 0;
+}
@@ -0,0 +1,158 @@
+/**
+ * Arduino.h (host)
+ *
+ * Minimal Arduino core for building the BQ25723 driver on a PC
+ * Provides only what the driver and benchmark use: integer types, timing,
+ * GPIO and interrupt stubs, PROGMEM accessors and Print.
+ */
+
+#ifndef BQ25723_HOST_ARDUINO_H
+#define BQ25723_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+
+typedef uint8_t byte;
+
+#define HEX 16
+#define DEC 10
+
+#define PROGMEM
+#define pgm_read_byte(p)  (*(const uint8_t*)(p))
+#define pgm_read_word(p)  (*(const uint16_t*)(p))
+#define pgm_read_dword(p) (*(const uint32_t*)(p))
+#define pgm_read_ptr(p)   (*(const void* const*)(p))
+
+// Offset added to the clock; tests advance time without sleeping
+inline uint32_t& hostClockOffsetUs() {
+    static uint32_t offset = 0;
+    return offset;
+}
+
+inline void hostAdvanceMs(uint32_t ms) {
+    hostClockOffsetUs() += ms * 1000;
+}
+
+inline uint32_t micros() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count() + hostClockOffsetUs();
+}
+
+inline uint32_t millis() {
+    return micros() / 1000;
+}
+
+inline void delay(uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+inline void delayMicroseconds(uint32_t us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+// No GPIO on the host: pins read as an idle (released) bus
+#define LOW          0
+#define HIGH         1
+#define INPUT        0
+#define OUTPUT       1
+#define INPUT_PULLUP 2
+
+static const uint8_t SDA = 0;
+static const uint8_t SCL = 1;
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) {
+    return HIGH;
+}
+
+// No interrupts on the host: handlers are never called
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+#define IRAM_ATTR
+
+inline int digitalPinToInterrupt(int pin) {
+    return pin;
+}
+inline void attachInterrupt(int, void (*)(), int) {}
+inline void detachInterrupt(int) {}
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    
+    virtual size_t write(const uint8_t* data, size_t size) {
+        size_t n = 0;
+        while (size--) n += write(*data++);
+        return n;
+    }
+    
+    size_t write(const char* s) {
+        return write((const uint8_t*)s, strlen(s));
+    }
+    
+    size_t print(const char* s) {
+        return write(s);
+    }
+    
+    size_t print(char c) {
+        return write((uint8_t)c);
+    }
+    
+    size_t print(unsigned long value, int base = DEC) {
+        char buffer[24];
+        snprintf(buffer, sizeof(buffer), base == HEX ? "%lX" : "%lu", value);
+        return write(buffer);
+    }
+    
+    size_t print(long value, int base = DEC) {
+        if (base == DEC) {
+            char buffer[24];
+            snprintf(buffer, sizeof(buffer), "%ld", value);
+            return write(buffer);
+        }
+        return print((unsigned long)value, base);
+    }
+    
+    size_t print(unsigned int value, int base = DEC) {
+        return print((unsigned long)value, base);
+    }
+    
+    size_t print(int value, int base = DEC) {
+        return print((long)value, base);
+    }
+    
+    size_t println() {
+        return write("\r\n");
+    }
+    
+    template <typename T>
+    size_t println(T value) {
+        return print(value) + println();
+    }
+    
+    virtual void flush() {}
+};
+
+// Print to stdout
+class HostSerial : public Print {
+public:
+    size_t write(uint8_t c) override {
+        return fwrite(&c, 1, 1, stdout);
+    }
+    
+    size_t write(const uint8_t* data, size_t size) override {
+        return fwrite(data, 1, size, stdout);
+    }
+    
+    using Print::write;
+};
+
+#endif // BQ25723_HOST_ARDUINO_H
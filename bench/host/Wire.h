@@ -0,0 +1,30 @@
+/**
+ * Wire.h (host)
+ *
+ * Placeholder TwoWire so BQ25723.hpp compiles on a PC
+ * No bus exists on the host; drivers are constructed on a BQ25723Transport
+ * such as BQ25723SimBus instead.
+ */
+
+#ifndef BQ25723_HOST_WIRE_H
+#define BQ25723_HOST_WIRE_H
+
+#include "Arduino.h"
+
+class TwoWire {
+public:
+    bool begin() { return false; }
+    bool begin(int, int) { return false; }
+    void end() {}
+    void setClock(uint32_t) {}
+    void beginTransmission(uint8_t) {}
+    uint8_t endTransmission(bool = true) { return 4; }
+    uint8_t requestFrom(uint8_t, uint8_t) { return 0; }
+    size_t write(uint8_t) { return 0; }
+    size_t write(const uint8_t*, size_t) { return 0; }
+    int read() { return -1; }
+};
+
+extern TwoWire Wire;
+
+#endif // BQ25723_HOST_WIRE_H
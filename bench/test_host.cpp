@@ -0,0 +1,433 @@
+/**
+ * test_host.cpp
+ *
+ * Host checks for the BQ25723 driver against the mock transport
+ * Asserts bus transaction counts and decoded values: first for the driver
+ * core (cache, updateBits suppression, field writes, watchdog piggybacking,
+ * recovery and fast start-up), then for the modules built on it (batch,
+ * bus manager, delta log, MPPT, scheduler, PROCHOT and the benchmark
+ * scenarios). Build and run from the repository root:
+ *
+ *   g++ -std=gnu++11 -Wall -Ibench/host -ISketch bench/test_host.cpp -o bq25723_test
+ *   ./bq25723_test
+ *
+ * Exits with status 1 if any check fails.
+ */
+
+#define BQ25723_ENABLE_STATS 1
+#define BQ25723_ENABLE_TRACE 1
+
+#include "BQ25723.hpp"
+#include "BQ25723Batch.hpp"
+#include "BQ25723Bench.hpp"
+#include "BQ25723Bus.hpp"
+#include "BQ25723Log.hpp"
+#include "BQ25723Mppt.hpp"
+#include "BQ25723Prochot.hpp"
+#include "BQ25723Scheduler.hpp"
+#include "BQ25723TransportMock.hpp"
+
+TwoWire Wire;
+
+static int failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        failures++; \
+    } \
+} while (0)
+
+// Transactions issued by a statement
+#define COUNT_TRANSACTIONS(mock, stmt) ((mock).resetCounters(), (void)(stmt), (mock).transactions())
+
+// Driver core
+
+static void testCache() {
+    BQ25723MockTransport mock;
+    BQ25723 charger(mock);
+    CHECK(charger.begin());
+    charger.enableCache(true);
+    mock.poke(BQ25723_REG_CHARGE_OPTION_0, 0x1234);
+    
+    uint16_t value = 0;
+    CHECK(COUNT_TRANSACTIONS(mock, charger.readRegister(BQ25723_REG_CHARGE_OPTION_0, &value)) == 1);
+    CHECK(value == 0x1234);
+    CHECK(COUNT_TRANSACTIONS(mock, charger.readRegister(BQ25723_REG_CHARGE_OPTION_0, &value)) == 0);
+    CHECK(value == 0x1234);
+    
+    // Status registers always go to the bus
+    CHECK(COUNT_TRANSACTIONS(mock, charger.readRegister(BQ25723_REG_CHARGER_STATUS, &value)) == 1);
+    CHECK(COUNT_TRANSACTIONS(mock, charger.readRegister(BQ25723_REG_CHARGER_STATUS, &value)) == 1);
+    
+    // A write updates the cached value without a read-back
+    CHECK(charger.writeRegister(BQ25723_REG_CHARGE_OPTION_0, 0x4321));
+    CHECK(COUNT_TRANSACTIONS(mock, charger.readRegister(BQ25723_REG_CHARGE_OPTION_0, &value)) == 0);
+    CHECK(value == 0x4321);
+    
+    // Also for registers never read before
+    CHECK(charger.writeRegister(BQ25723_REG_VSYS_MIN, 0x2400));
+    CHECK(COUNT_TRANSACTIONS(mock, charger.readRegister(BQ25723_REG_VSYS_MIN, &value)) == 0);
+    CHECK(value == 0x2400);
+    
+    // A register reset drops every cached value
+    CHECK(charger.writeRegister(BQ25723_REG_CHARGE_OPTION_3, BQ25723Fields::RESET_REG::encode(1)));
+    CHECK(COUNT_TRANSACTIONS(mock, charger.readRegister(BQ25723_REG_CHARGE_OPTION_0, &value)) == 1);
+}
+
+static void testUpdateBits() {
+    BQ25723MockTransport mock;
+    BQ25723 charger(mock);
+    CHECK(charger.begin());
+    charger.enableCache(true);
+    mock.poke(BQ25723_REG_CHARGE_OPTION_0, 0x00F0);
+    
+    // First call reads; an unchanged result suppresses the write
+    CHECK(COUNT_TRANSACTIONS(mock, charger.updateBits(BQ25723_REG_CHARGE_OPTION_0, 0x00F0, 0x00F0)) == 1);
+    CHECK(COUNT_TRANSACTIONS(mock, charger.updateBits(BQ25723_REG_CHARGE_OPTION_0, 0x00F0, 0x00F0)) == 0);
+    
+    CHECK(COUNT_TRANSACTIONS(mock, charger.updateBits(BQ25723_REG_CHARGE_OPTION_0, 0x000F, 0x0005)) == 1);
+    CHECK(mock.peek(BQ25723_REG_CHARGE_OPTION_0) == 0x00F5);
+}
+
+static void testWriteFieldLocal() {
+    using namespace BQ25723Fields;
+    BQ25723MockTransport mock;
+    BQ25723 charger(mock);
+    CHECK(charger.begin());
+    charger.enableCache(true);
+    mock.poke(BQ25723_REG_CHARGE_CURRENT, 0x0100);
+    
+    uint16_t value;
+    CHECK(charger.readRegister(BQ25723_REG_CHARGE_CURRENT, &value));
+    
+    // Each new code is computed from the cached word: one write, no read
+    CHECK(COUNT_TRANSACTIONS(mock, charger.writeField<CHARGE_CURRENT>(10)) == 1);
+    CHECK(CHARGE_CURRENT::get(mock.peek(BQ25723_REG_CHARGE_CURRENT)) == 10);
+    CHECK(COUNT_TRANSACTIONS(mock, charger.writeField<CHARGE_CURRENT>(20)) == 1);
+    CHECK(CHARGE_CURRENT::get(mock.peek(BQ25723_REG_CHARGE_CURRENT)) == 20);
+    CHECK(COUNT_TRANSACTIONS(mock, charger.writeField<CHARGE_CURRENT>(20)) == 0);
+}
+
+static void testWatchdogPiggyback() {
+    BQ25723MockTransport mock;
+    BQ25723 charger(mock);
+    CHECK(charger.begin());
+    mock.poke(BQ25723_REG_CHARGE_VOLTAGE, 0x3480);
+    
+    uint16_t value;
+    CHECK(charger.readRegister(BQ25723_REG_CHARGE_VOLTAGE, &value));
+    CHECK(charger.enableWatchdog(BQ25723_WATCHDOG_5S));
+    
+    // Before the piggyback point a write stays a single word
+    mock.resetCounters();
+    CHECK(charger.writeRegister(BQ25723_REG_OTG_VOLTAGE, 0x0100));
+    uint32_t singleBytes = mock.bytes();
+    
+    // Past it, the write starting just above CHARGE_VOLTAGE rewrites it too
+    hostAdvanceMs(3000);
+    mock.resetCounters();
+    CHECK(charger.writeRegister(BQ25723_REG_OTG_VOLTAGE, 0x0200));
+    CHECK(mock.transactions() == 1);
+    CHECK(mock.bytes() == singleBytes + 2);
+    CHECK(mock.peek(BQ25723_REG_CHARGE_VOLTAGE) == 0x3480);
+    CHECK(mock.peek(BQ25723_REG_OTG_VOLTAGE) == 0x0200);
+    CHECK(charger.getWatchdogRemainingMs() > 4000);
+    
+    // Freshly kicked: the service generates no traffic
+    CHECK(COUNT_TRANSACTIONS(mock, charger.serviceWatchdog()) == 0);
+}
+
+static void testRecoveryRetry() {
+    BQ25723MockTransport mock;
+    BQ25723 charger(mock);
+    CHECK(charger.begin());
+    charger.setAutoRecover(true);
+    charger.resetStats();
+    while (charger.getTracePending()) {
+        BQ25723BufferPrint sink(nullptr, 0);
+        charger.drainTrace(sink);
+    }
+    
+    // The failed attempt, the recovery probe and the retry are all recorded
+    mock.poke(BQ25723_REG_CHARGER_STATUS, 0x8000);
+    mock.failNext(1, BQ25723_BUS_ERROR);
+    uint16_t value = 0;
+    CHECK(charger.readRegister(BQ25723_REG_CHARGER_STATUS, &value));
+    CHECK(value == 0x8000);
+    CHECK(mock.recoveries() == 1);
+    CHECK(charger.getRecoveryCount() == 1);
+    
+    BQ25723BusStats stats;
+    charger.getStats(&stats);
+    CHECK(stats.reads[BQ25723_REG_CHARGER_STATUS >> 1] == 2);
+    CHECK(stats.failures == 1);
+    CHECK(stats.transactions == charger.getTracePending());
+}
+
+static void testLinkDownRecovery() {
+    BQ25723MockTransport mock;
+    BQ25723 charger(mock);
+    CHECK(charger.begin());
+    charger.setAutoRecover(true);
+    mock.poke(BQ25723_REG_CHARGER_STATUS, 0x8000);
+    
+    // The bus stays stuck through the first recovery's attempts
+    mock.failUntilRecovered(BQ25723_RECOVERY_ATTEMPTS + 2);
+    uint16_t value = 0;
+    CHECK(!charger.readRegister(BQ25723_REG_CHARGER_STATUS, &value));
+    CHECK(charger.isLinkDown());
+    CHECK(charger.isInitialized());
+    
+    // Before the retry time accesses fail without bus traffic
+    CHECK(COUNT_TRANSACTIONS(mock, charger.readRegister(BQ25723_REG_CHARGER_STATUS, &value)) == 0);
+    CHECK(charger.getLastStatus() == BQ25723_BUS_NOT_READY);
+    
+    // Then the next access recovers and succeeds
+    mock.resetCounters();
+    hostAdvanceMs(BQ25723_RECOVERY_RETRY_MS);
+    CHECK(charger.readRegister(BQ25723_REG_CHARGER_STATUS, &value));
+    CHECK(value == 0x8000);
+    CHECK(!charger.isLinkDown());
+    CHECK(charger.getRecoveryCount() == 1);
+    CHECK(mock.recoveries() == 2);   // Freed on the second attempt
+}
+
+static void testBeginFast() {
+    BQ25723MockTransport mock(BQ25723_I2C_ADDR_ALT);
+    BQ25723 charger(mock, BQ25723_I2C_ADDR_DEFAULT, BQ25723_I2C_SPEED_FAST);
+    
+    BQ25723Config config;
+    memset(&config, 0, sizeof(config));
+    config.validMask = 1;               // CHARGE_OPTION_0 only
+    config.words[0] = 0xE70E;
+    mock.poke(BQ25723_REG_CHARGE_OPTION_0, 0xE70E);
+    
+    uint8_t written = 0xFF;
+    CHECK(charger.beginFast(&config, &written));
+    CHECK(written == 0);
+    CHECK(charger.getAddress() == BQ25723_I2C_ADDR_ALT);
+    CHECK(mock.clock() == BQ25723_I2C_SPEED_FAST);
+    
+    mock.poke(BQ25723_REG_CHARGE_OPTION_0, 0x0000);
+    CHECK(charger.beginFast(&config, &written));
+    CHECK(written == 1);
+    CHECK(mock.peek(BQ25723_REG_CHARGE_OPTION_0) == 0xE70E);
+}
+
+// Modules
+
+static void testBatch() {
+    BQ25723MockTransport mock;
+    BQ25723 charger(mock);
+    CHECK(charger.begin());
+    
+    BQ25723Batch batch(charger);
+    batch.write(BQ25723_REG_CHARGE_CURRENT, 0x0100);
+    batch.write(BQ25723_REG_CHARGE_VOLTAGE, 0x2000);
+    batch.write(BQ25723_REG_CHARGE_CURRENT, 0x0200);   // Replaces the first write
+    CHECK(COUNT_TRANSACTIONS(mock, batch.commit()) == 1);
+    CHECK(batch.lastTransactionCount() == 1);
+    CHECK(mock.peek(BQ25723_REG_CHARGE_CURRENT) == 0x0200);
+    CHECK(mock.peek(BQ25723_REG_CHARGE_VOLTAGE) == 0x2000);
+    CHECK(batch.isEmpty());
+    
+    // Read-only and unknown registers are never written
+    uint16_t value;
+    CHECK(!batch.write(BQ25723_REG_ADCIBAT, 0x1234));
+    CHECK(!batch.write(BQ25723_REG_MANUFACTURER_ID, 0x1234));
+    CHECK(!batch.write(0x10, 0x1234));
+    CHECK(!batch.read(0x10, &value));
+    CHECK(batch.isEmpty());
+    CHECK(COUNT_TRANSACTIONS(mock, batch.commit()) == 0);
+    CHECK(mock.peek(BQ25723_REG_ADCIBAT) == 0);
+}
+
+static void testBusAccess() {
+    BQ25723MockTransport mock;
+    BQ25723 charger(mock);
+    BQ25723Bus bus(&Wire);
+    CHECK(bus.begin());
+    CHECK(bus.addDevice(charger) == 0);
+    
+    {
+        BQ25723Bus::Access device = bus.access(0);
+        CHECK(device);
+        uint16_t value = 0;
+        CHECK(COUNT_TRANSACTIONS(mock, device->readRegister(BQ25723_REG_MANUFACTURER_ID, &value)) == 1);
+        CHECK((value & 0xFF) == 0x40);
+    }
+    CHECK(!bus.access(1));
+    
+    BQ25723Telemetry telemetry;
+    CHECK(COUNT_TRANSACTIONS(mock, bus.pollNext(&telemetry)) == 1);
+    CHECK(COUNT_TRANSACTIONS(mock, bus.pollAll(&telemetry)) == 1);
+}
+
+static void testLogRoundTrip() {
+    uint8_t buffer[512];
+    BQ25723BufferPrint out(buffer, sizeof(buffer));
+    BQ25723LogEncoder encoder(out);
+    
+    BQ25723LogSnapshot snapshots[3];
+    memset(snapshots, 0, sizeof(snapshots));
+    for (uint8_t i = 0; i < 3; i++) {
+        snapshots[i].timestampMs = 1000 + 250 * i;
+        snapshots[i].registers.validMask = 0x0000FFFFUL;
+        for (uint8_t r = 0; r < 16; r++) {
+            snapshots[i].registers.words[r] = (uint16_t)(0x1000 * r + (i == 2 && r == 5 ? 0x0042 : 0));
+        }
+        CHECK(encoder.write(snapshots[i]) > 0);
+    }
+    CHECK(!out.overflowed());
+    CHECK(buffer[0] == BQ25723_LOG_KEYFRAME);
+    
+    BQ25723LogDecoder decoder;
+    size_t pos = 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        BQ25723LogSnapshot decoded;
+        size_t n = decoder.decode(&buffer[pos], out.length() - pos, &decoded);
+        CHECK(n > 0);
+        if (!n) return;
+        pos += n;
+        CHECK(decoded.timestampMs == snapshots[i].timestampMs);
+        CHECK(decoded.registers.validMask == snapshots[i].registers.validMask);
+        CHECK(memcmp(decoded.registers.words, snapshots[i].registers.words, 16 * sizeof(uint16_t)) == 0);
+    }
+    CHECK(pos == out.length());
+}
+
+static void testMpptKeepsAdcChannels() {
+    BQ25723MockTransport mock;
+    BQ25723 charger(mock);
+    CHECK(charger.begin());
+    CHECK(charger.configureAdc(BQ25723_ADC_CONTINUOUS, BQ25723_ADC_CH_VBAT | BQ25723_ADC_CH_ICHG));
+    
+    BQ25723VinMppt mppt(charger);
+    CHECK(mppt.begin(5000, 20000, 12000));
+    uint16_t channels = BQ25723Fields::EN_ADC::get(mock.peek(BQ25723_REG_ADC_OPTION));
+    CHECK(channels == (BQ25723_ADC_CH_VBAT | BQ25723_ADC_CH_ICHG |
+                       BQ25723_ADC_CH_VBUS | BQ25723_ADC_CH_IIN));
+}
+
+static void testSchedulerAdcFailures() {
+    BQ25723MockTransport mock;
+    BQ25723 charger(mock);
+    CHECK(charger.begin());
+    
+    // No adapter: one-shot conversions on battery
+    BQ25723Scheduler scheduler(charger);
+    CHECK(scheduler.begin());
+    CHECK(scheduler.getState() == BQ25723_POWER_BATTERY);
+    uint16_t adcOption = mock.peek(BQ25723_REG_ADC_OPTION);
+    
+    // A failed reconfiguration keeps the old mode
+    mock.failNext(1);
+    CHECK(!scheduler.setAdcMode(BQ25723_POWER_BATTERY, BQ25723_ADC_CONTINUOUS));
+    CHECK(mock.peek(BQ25723_REG_ADC_OPTION) == adcOption);
+    
+    // A failed done-check skips the telemetry read
+    hostAdvanceMs(BQ25723_SCHEDULER_BATTERY_MS);
+    CHECK(!scheduler.update());
+    CHECK(BQ25723Fields::ADC_START::get(mock.peek(BQ25723_REG_ADC_OPTION)));
+    hostAdvanceMs(BQ25723_SCHEDULER_CONVERSION_MS);
+    mock.poke(BQ25723_REG_ADC_OPTION, adcOption);
+    mock.failNext(1);
+    bool polled = true;
+    CHECK(COUNT_TRANSACTIONS(mock, polled = scheduler.update()) == 1);
+    CHECK(!polled);
+    CHECK(scheduler.getErrorCount() == 1);
+    
+    // Once the check succeeds the results are read
+    hostAdvanceMs(BQ25723_SCHEDULER_CONVERSION_MS);
+    CHECK(scheduler.update());
+    
+    // A failed switch to continuous mode stays on battery: the done-check
+    // and the telemetry read pass, configureAdc() fails
+    BQ25723Telemetry telemetry;
+    uint32_t telemetryTx = COUNT_TRANSACTIONS(mock, charger.readTelemetry(&telemetry));
+    mock.poke(BQ25723_REG_CHARGER_STATUS, BQ25723Fields::AC_STAT::encode(1));
+    scheduler.wake();
+    CHECK(!scheduler.update());   // Starts the conversion
+    hostAdvanceMs(BQ25723_SCHEDULER_CONVERSION_MS);
+    mock.poke(BQ25723_REG_ADC_OPTION, adcOption);
+    mock.failAfter(1 + telemetryTx, 1);
+    CHECK(!scheduler.update());
+    CHECK(scheduler.getState() == BQ25723_POWER_BATTERY);
+    CHECK(scheduler.getErrorCount() == 2);
+    
+    // The change is retried at the next poll
+    hostAdvanceMs(BQ25723_SCHEDULER_BATTERY_MS);
+    mock.poke(BQ25723_REG_ADC_OPTION, adcOption);
+    scheduler.update();
+    hostAdvanceMs(BQ25723_SCHEDULER_CONVERSION_MS);
+    mock.poke(BQ25723_REG_ADC_OPTION, adcOption);
+    CHECK(scheduler.update());
+    CHECK(scheduler.getState() == BQ25723_POWER_ADAPTER);
+    CHECK(BQ25723Fields::ADC_CONV::get(mock.peek(BQ25723_REG_ADC_OPTION)) == BQ25723_ADC_CONTINUOUS);
+}
+
+static void testProchotIlim2Range() {
+    BQ25723MockTransport mock;
+    BQ25723 charger(mock);
+    CHECK(charger.begin());
+    BQ25723Prochot prochot(charger);
+    
+    BQ25723ProchotConfig config;
+    memset(&config, 0, sizeof(config));
+    config.ilim2Percent = 260;   // Top code
+    CHECK(prochot.configure(config));
+    CHECK(BQ25723Fields::ILIM2_VTH::get(mock.peek(BQ25723_REG_PROCHOT_OPTION_0)) == 31);
+    
+    BQ25723ProchotConfig readBack;
+    CHECK(prochot.readConfig(&readBack));
+    CHECK(readBack.ilim2Percent == 260);
+    
+    // Out of range thresholds are rejected before any bus traffic
+    bool ok = true;
+    config.ilim2Percent = 105;
+    CHECK(COUNT_TRANSACTIONS(mock, ok = prochot.configure(config)) == 0);
+    CHECK(!ok);
+    config.ilim2Percent = 265;
+    CHECK(COUNT_TRANSACTIONS(mock, ok = prochot.configure(config)) == 0);
+    CHECK(!ok);
+}
+
+static void testBenchTransactions() {
+    const uint32_t iterations = 10;
+    BQ25723Bench bench;
+    bench.setClock(BQ25723_I2C_SPEED_FAST);
+    
+    CHECK(bench.fullDump(iterations).transactions == 2 * iterations);       // Two bursts
+    CHECK(bench.adcSnapshot(iterations).transactions == iterations);        // One burst
+    CHECK(bench.configApply(iterations).transactions == 4 * iterations);    // Two reads, two write runs
+    
+    // One burst per device per round through the bus manager
+    BQ25723BenchResult result = bench.multiDevicePoll(iterations);
+    CHECK(result.transactions == 4 * iterations);
+    CHECK(result.busTimeUs > 0);
+}
+
+int main() {
+    testCache();
+    testUpdateBits();
+    testWriteFieldLocal();
+    testWatchdogPiggyback();
+    testRecoveryRetry();
+    testLinkDownRecovery();
+    testBeginFast();
+    testBatch();
+    testBusAccess();
+    testLogRoundTrip();
+    testMpptKeepsAdcChannels();
+    testSchedulerAdcFailures();
+    testProchotIlim2Range();
+    testBenchTransactions();
+    
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("All checks passed\n");
+    return 0;
+}
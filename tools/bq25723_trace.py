@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+"""
+bq25723_trace.py
+
+Decode a BQ25723 bus trace (BQ25723_ENABLE_TRACE, drainTrace()) and report
+bus utilisation and the most used registers.
+
+Capture the drained packets to a file (for example a serial terminal's
+binary log, or `cat /dev/ttyUSB0 > trace.bin` after setting the port up with
+stty), then run:
+    tools/bq25723_trace.py trace.bin
+    tools/bq25723_trace.py --csv trace.bin > trace.csv
+"""
+
+import argparse
+import struct
+import sys
+
+PACKET_TAG = 0xB3
+PACKET_HEADER = struct.Struct("<BBI")      # tag, count, dropped total
+ENTRY = struct.Struct("<IHHBBBB")          # timestamp, latency, value, reg, count, flags, status
+MAX_ENTRIES = 16
+FLAG_WRITE = 0x01
+
+REGISTERS = {
+    0x00: "CHARGE_OPTION_0", 0x02: "CHARGE_CURRENT", 0x04: "CHARGE_VOLTAGE",
+    0x06: "OTG_VOLTAGE", 0x08: "OTG_CURRENT", 0x0A: "INPUT_VOLTAGE",
+    0x0C: "VSYS_MIN", 0x0E: "IIN_HOST", 0x20: "CHARGER_STATUS",
+    0x22: "PROCHOT_STATUS", 0x24: "IIN_DPM", 0x26: "ADCVBUS_PSYS",
+    0x28: "ADCIBAT", 0x2A: "ADCIINCMPIN", 0x2C: "ADCVSYSVBAT",
+    0x2E: "MANUFACTURER_ID", 0x2F: "DEVICE_ID", 0x30: "CHARGE_OPTION_1",
+    0x32: "CHARGE_OPTION_2", 0x34: "CHARGE_OPTION_3", 0x36: "PROCHOT_OPTION_0",
+    0x38: "PROCHOT_OPTION_1", 0x3A: "ADC_OPTION", 0x3C: "CHARGE_OPTION_4",
+    0x3E: "VMIN_ACT_PROT",
+}
+
+STATUS = {
+    0: "OK", 1: "DATA_TOO_LONG", 2: "NACK_ADDRESS", 3: "NACK_DATA",
+    4: "BUS_ERROR", 5: "TIMEOUT", 6: "SHORT_READ", 7: "NOT_READY",
+}
+
+
+def register_name(addr):
+    return REGISTERS.get(addr, "0x%02X" % addr)
+
+
+def decode(data):
+    """Decode packets, skipping bytes that do not parse.
+
+    Returns the entries, the last dropped total seen and the skipped byte count.
+    """
+    entries = []
+    dropped = 0
+    skipped = 0
+    pos = 0
+    epoch = 0          # Added to timestamps to undo u32 wrap-around
+    last = None
+    while pos + PACKET_HEADER.size <= len(data):
+        tag, count, total_dropped = PACKET_HEADER.unpack_from(data, pos)
+        end = pos + PACKET_HEADER.size + count * ENTRY.size
+        if tag != PACKET_TAG or count == 0 or count > MAX_ENTRIES or end > len(data):
+            pos += 1   # Resynchronize on the next tag byte
+            skipped += 1
+            continue
+        dropped = total_dropped
+        offset = pos + PACKET_HEADER.size
+        for _ in range(count):
+            ts, latency, value, reg, words, flags, status = ENTRY.unpack_from(data, offset)
+            offset += ENTRY.size
+            if last is not None and ts + epoch < last - (1 << 31):
+                epoch += 1 << 32
+            last = ts + epoch
+            entries.append({
+                "time_us": ts + epoch,
+                "latency_us": latency,
+                "value": value,
+                "reg": reg,
+                "words": words,
+                "write": bool(flags & FLAG_WRITE),
+                "status": status,
+            })
+        pos = end
+    return entries, dropped, skipped
+
+
+def report(entries, dropped, skipped, top, out):
+    if not entries:
+        out.write("No trace entries decoded.\n")
+        return
+
+    start = min(e["time_us"] for e in entries)
+    stop = max(e["time_us"] + e["latency_us"] for e in entries)
+    span = max(stop - start, 1)
+    busy = sum(e["latency_us"] for e in entries)
+    failures = [e for e in entries if e["status"] != 0]
+
+    out.write("Entries:      %d (%d dropped on target, %d bytes skipped)\n"
+              % (len(entries), dropped, skipped))
+    out.write("Span:         %.3f ms\n" % (span / 1000.0))
+    out.write("Bus busy:     %.3f ms (%.1f %% utilisation)\n"
+              % (busy / 1000.0, 100.0 * busy / span))
+    out.write("Transactions: %.1f per second\n" % (len(entries) * 1e6 / span))
+
+    if failures:
+        by_status = {}
+        for e in failures:
+            by_status[e["status"]] = by_status.get(e["status"], 0) + 1
+        out.write("Failures:     %d (%s)\n" % (len(failures), ", ".join(
+            "%s %d" % (STATUS.get(s, str(s)), n) for s, n in sorted(by_status.items()))))
+
+    per_reg = {}
+    for e in entries:
+        r = per_reg.setdefault(e["reg"], {"reads": 0, "writes": 0, "failures": 0,
+                                          "busy": 0, "max": 0, "words": 0})
+        r["writes" if e["write"] else "reads"] += 1
+        r["failures"] += e["status"] != 0
+        r["busy"] += e["latency_us"]
+        r["max"] = max(r["max"], e["latency_us"])
+        r["words"] += e["words"]
+
+    out.write("\nHot registers (by transactions, bursts counted at their start address):\n")
+    out.write("%-18s %6s %6s %6s %5s %9s %7s %7s %6s\n" % (
+        "Register", "Reads", "Writes", "Fails", "Words", "Busy us", "Avg us", "Max us", "Busy%"))
+    ranked = sorted(per_reg.items(), key=lambda kv: kv[1]["reads"] + kv[1]["writes"], reverse=True)
+    for reg, r in ranked[:top]:
+        n = r["reads"] + r["writes"]
+        out.write("%-18s %6d %6d %6d %5.1f %9d %7.1f %7d %6.1f\n" % (
+            register_name(reg), r["reads"], r["writes"], r["failures"], r["words"] / float(n),
+            r["busy"], r["busy"] / float(n), r["max"], 100.0 * r["busy"] / max(busy, 1)))
+
+
+def write_csv(entries, out):
+    out.write("time_us,latency_us,register,address,op,words,value,status\n")
+    for e in entries:
+        out.write("%d,%d,%s,0x%02X,%s,%d,0x%04X,%s\n" % (
+            e["time_us"], e["latency_us"], register_name(e["reg"]), e["reg"],
+            "W" if e["write"] else "R", e["words"], e["value"],
+            STATUS.get(e["status"], str(e["status"]))))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode a BQ25723 bus trace")
+    parser.add_argument("trace", help="binary trace file, or - for stdin")
+    parser.add_argument("--top", type=int, default=10, help="registers to list (default 10)")
+    parser.add_argument("--csv", action="store_true", help="print decoded entries as CSV")
+    args = parser.parse_args()
+
+    if args.trace == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.trace, "rb") as f:
+            data = f.read()
+
+    entries, dropped, skipped = decode(data)
+    if args.csv:
+        write_csv(entries, sys.stdout)
+    else:
+        report(entries, dropped, skipped, args.top, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()